@@ -0,0 +1,138 @@
+/**
+ * @file bench_mpmc_queue.c
+ * @author Secareanu Filip
+ * @brief   Contention benchmark of the MPMC queue against a mutex-protected queue_t.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every thread repeatedly enqueues an element and dequeues one, so all threads
+ * hammer both ends of the same queue. The benchmark reports the average time
+ * per operation (enqueue or dequeue) for 1 to 64 threads, for the lock-free
+ * mpmc_queue_t and for a queue_t wrapped in a pthread mutex.
+ *
+ * Build and run with: make bench && ./bin/bench_mpmc_queue
+ */
+
+#include "../src/queue/mpmc_queue.h"
+#include "../src/queue/queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_TOTAL_PAIRS 4000000
+#define BENCH_CAPACITY 1024
+
+typedef struct bench_context bench_context_t;
+
+struct bench_context {
+    mpmc_queue_t *mpmc;
+    queue_t *queue;
+    pthread_mutex_t lock;
+    size_t pairs;
+    pthread_barrier_t barrier;
+};
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void *bench_mpmc_worker(void *arg)
+{
+    bench_context_t *context = arg;
+    uint64_t value = 0;
+
+    pthread_barrier_wait(&context->barrier);
+
+    for (size_t i = 0; i < context->pairs; i++) {
+        while (!mpmc_queue_try_enqueue(context->mpmc, &value)) {
+            sched_yield();
+        }
+        while (!mpmc_queue_try_dequeue(context->mpmc, &value)) {
+            sched_yield();
+        }
+        value++;
+    }
+
+    return NULL;
+}
+
+static void *bench_locked_worker(void *arg)
+{
+    bench_context_t *context = arg;
+    uint64_t value = 0;
+
+    pthread_barrier_wait(&context->barrier);
+
+    for (size_t i = 0; i < context->pairs; i++) {
+        pthread_mutex_lock(&context->lock);
+        queue_enqueue(context->queue, &value);
+        pthread_mutex_unlock(&context->lock);
+
+        // Every thread enqueues before it dequeues, so the queue is never
+        // empty here
+        pthread_mutex_lock(&context->lock);
+        value = *(uint64_t *)queue_dequeue(context->queue);
+        pthread_mutex_unlock(&context->lock);
+
+        value++;
+    }
+
+    return NULL;
+}
+
+static double bench_run(bench_context_t *context, size_t threads, void *(*worker)(void *))
+{
+    pthread_t handles[64];
+
+    context->pairs = BENCH_TOTAL_PAIRS / threads;
+    pthread_barrier_init(&context->barrier, NULL, (unsigned int)threads + 1);
+
+    for (size_t i = 0; i < threads; i++) {
+        pthread_create(&handles[i], NULL, worker, context);
+    }
+
+    double start = now_ns();
+    pthread_barrier_wait(&context->barrier);
+
+    for (size_t i = 0; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+    }
+
+    double elapsed = now_ns() - start;
+
+    pthread_barrier_destroy(&context->barrier);
+
+    return elapsed / (double)(context->pairs * threads * 2);
+}
+
+int main(void)
+{
+    bench_context_t context;
+
+    context.mpmc = mpmc_queue_create(sizeof(uint64_t), BENCH_CAPACITY, NULL, NULL);
+    context.queue = queue_create(sizeof(uint64_t), BENCH_CAPACITY, 1.0f, 0.0f, NULL, NULL);
+    pthread_mutex_init(&context.lock, NULL);
+
+    printf("%-8s %14s %14s\n", "threads", "mpmc", "mutex queue");
+
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        double mpmc = bench_run(&context, threads, bench_mpmc_worker);
+        double locked = bench_run(&context, threads, bench_locked_worker);
+
+        printf("%-8zu %11.1f ns %11.1f ns\n", threads, mpmc, locked);
+    }
+
+    pthread_mutex_destroy(&context.lock);
+    mpmc_queue_destroy(&context.mpmc, CF_NONE);
+    queue_destroy(&context.queue, CF_NONE);
+
+    return 0;
+}
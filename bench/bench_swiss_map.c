@@ -0,0 +1,148 @@
+/**
+ * @file bench_swiss_map.c
+ * @author Secareanu Filip
+ * @brief   Lookup benchmark of the SwissTable-style map against the linear-probing hash table.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Both containers get the same number of slots (BENCH_SLOTS) and are filled
+ * to 50-90% of it with random 64-bit keys. For every load the benchmark times
+ * successful lookups (in random order) and unsuccessful ones, and reports the
+ * average time per lookup.
+ *
+ * Build and run with: make bench && ./bin/bench_swiss_map
+ */
+
+#include "../src/hash_table/hash_table.h"
+#include "../src/hash_table/swiss_map.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_SLOTS ((size_t)1 << 20)
+#define BENCH_ROUNDS 3
+
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_hash_table(hash_table_t *table, const uint64_t *keys, size_t count, uint64_t *checksum)
+{
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        double start = now_ns();
+
+        for (size_t i = 0; i < count; i++) {
+            uint64_t *value = hash_table_get(table, &keys[i]);
+            *checksum += value != NULL ? *value : 1;
+        }
+
+        double elapsed = (now_ns() - start) / (double)count;
+        if (round == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+static double bench_swiss_map(swiss_map_t *map, const uint64_t *keys, size_t count, uint64_t *checksum)
+{
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        double start = now_ns();
+
+        for (size_t i = 0; i < count; i++) {
+            uint64_t *value = swiss_map_get(map, &keys[i]);
+            *checksum += value != NULL ? *value : 1;
+        }
+
+        double elapsed = (now_ns() - start) / (double)count;
+        if (round == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+int main(void)
+{
+    size_t max_count = BENCH_SLOTS * 9 / 10;
+    uint64_t *keys = malloc(max_count * sizeof(uint64_t));
+    uint64_t *hits = malloc(max_count * sizeof(uint64_t));
+    uint64_t *misses = malloc(max_count * sizeof(uint64_t));
+    uint64_t state = 42;
+    uint64_t checksum = 0;
+
+    for (size_t i = 0; i < max_count; i++) {
+        keys[i] = splitmix64(&state);
+    }
+    for (size_t i = 0; i < max_count; i++) {
+        misses[i] = splitmix64(&state);
+    }
+
+    // Same slot count for both: the load factors are capped so neither grows
+    hash_table_t *table = hash_table_create(sizeof(uint64_t), sizeof(uint64_t), max_count, 0.95f, NULL, NULL, NULL, NULL);
+    swiss_map_t *map = swiss_map_create(sizeof(uint64_t), sizeof(uint64_t), max_count, 0.95f, NULL, NULL, NULL, NULL);
+
+    printf("slots: %zu (hash table), %zu (swiss map)\n", table->capacity, map->capacity);
+    printf("%-6s %14s %14s %14s %14s\n", "load", "linear hit", "swiss hit", "linear miss", "swiss miss");
+
+    for (int load = 50; load <= 90; load += 10) {
+        size_t count = BENCH_SLOTS * (size_t)load / 100;
+
+        hash_table_clear(table, CF_NONE);
+        swiss_map_clear(map, CF_NONE);
+
+        for (size_t i = 0; i < count; i++) {
+            hash_table_insert(table, &keys[i], &keys[i]);
+            swiss_map_insert(map, &keys[i], &keys[i]);
+        }
+
+        // Look the keys up in an order unrelated to insertion
+        memcpy(hits, keys, count * sizeof(uint64_t));
+        for (size_t i = count - 1; i > 0; i--) {
+            size_t j = splitmix64(&state) % (i + 1);
+            uint64_t tmp = hits[i];
+            hits[i] = hits[j];
+            hits[j] = tmp;
+        }
+
+        double linear_hit = bench_hash_table(table, hits, count, &checksum);
+        double swiss_hit = bench_swiss_map(map, hits, count, &checksum);
+        double linear_miss = bench_hash_table(table, misses, count, &checksum);
+        double swiss_miss = bench_swiss_map(map, misses, count, &checksum);
+
+        printf("%3d%%   %11.1f ns %11.1f ns %11.1f ns %11.1f ns\n", load, linear_hit, swiss_hit, linear_miss, swiss_miss);
+    }
+
+    printf("checksum: %llu\n", (unsigned long long)checksum);
+
+    hash_table_destroy(&table, CF_NONE);
+    swiss_map_destroy(&map, CF_NONE);
+
+    free(keys);
+    free(hits);
+    free(misses);
+
+    return 0;
+}
@@ -20,7 +20,8 @@ enum container_error {
     ERROR_INVALID_DATA,         // 3
     ERROR_INVALID_INDEX,        // 4
     ERROR_INVALID_FUNCTION,     // 5
-    ERROR_EMPTY                 // 6
+    ERROR_EMPTY,                // 6
+    ERROR_NOT_FOUND             // 7
 };
 
 #endif // ERROR_H
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+ * @file arena.c
+ * @author Secareanu Filip
+ * @brief   This module implements the bump-pointer arena allocator.
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include "arena.h"
+
+static size_t arena_round(size_t size)
+{
+    size_t align = _Alignof(max_align_t);
+
+    if (size == 0) {
+        return align;
+    }
+
+    return (size + align - 1) / align * align;
+}
+
+static arena_chunk_t *arena_next_chunk(arena_t *arena, size_t size)
+{
+    arena_chunk_t *next = arena->current != NULL ? arena->current->next : NULL;
+
+    if (next != NULL && next->capacity >= size) {
+        next->used = 0;
+        arena->current = next;
+        return next;
+    }
+
+    size_t capacity = size > arena->chunk_size ? size : arena->chunk_size;
+
+    arena_chunk_t *chunk = SAFE_MALLOC(sizeof(arena_chunk_t) + capacity);
+    chunk->next = next;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+
+    if (arena->current == NULL) {
+        arena->first = chunk;
+    } else {
+        arena->current->next = chunk;
+    }
+    arena->current = chunk;
+
+    return chunk;
+}
+
+arena_t *arena_create(size_t chunk_size)
+{
+    arena_t *arena = SAFE_CALLOC(1, sizeof(arena_t));
+
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->chunk_size = arena_round(chunk_size);
+
+    return arena;
+}
+
+void arena_destroy(arena_t **arena)
+{
+    if (*arena == NULL) {
+        return;
+    }
+
+    arena_chunk_t *chunk = (*arena)->first;
+
+    while (chunk != NULL) {
+        arena_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(*arena);
+    *arena = NULL;
+}
+
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    size = arena_round(size);
+
+    arena_chunk_t *chunk = arena->current;
+
+    if (chunk == NULL || chunk->capacity - chunk->used < size) {
+        chunk = arena_next_chunk(arena, size);
+    }
+
+    void *ptr = chunk->memory + chunk->used;
+    chunk->used += size;
+
+    return ptr;
+}
+
+arena_mark_t arena_mark(arena_t *arena)
+{
+    arena_mark_t mark = { NULL, 0 };
+
+    if (arena == NULL || arena->current == NULL) {
+        return mark;
+    }
+
+    mark.chunk = arena->current;
+    mark.used = arena->current->used;
+
+    return mark;
+}
+
+void arena_rewind(arena_t *arena, arena_mark_t mark)
+{
+    if (arena == NULL) {
+        return;
+    }
+
+    if (mark.chunk == NULL) {
+        arena_reset(arena);
+        return;
+    }
+
+    arena->current = mark.chunk;
+    arena->current->used = mark.used;
+}
+
+void arena_reset(arena_t *arena)
+{
+    if (arena == NULL) {
+        return;
+    }
+
+    arena->current = arena->first;
+
+    if (arena->current != NULL) {
+        arena->current->used = 0;
+    }
+}
+
+static void *arena_allocator_alloc(void *context, size_t size)
+{
+    return arena_alloc(context, size);
+}
+
+static void *arena_allocator_realloc(void *context, void *ptr, size_t old_size, size_t new_size)
+{
+    arena_t *arena = context;
+    arena_chunk_t *chunk = arena->current;
+
+    old_size = arena_round(old_size);
+
+    // The last block of the current chunk can be resized in place
+    if (chunk != NULL && (unsigned char *)ptr + old_size == chunk->memory + chunk->used) {
+        size_t offset = (unsigned char *)ptr - chunk->memory;
+
+        if (chunk->capacity - offset >= arena_round(new_size)) {
+            chunk->used = offset + arena_round(new_size);
+            return ptr;
+        }
+    }
+
+    void *new_ptr = arena_alloc(arena, new_size);
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+
+    return new_ptr;
+}
+
+allocator_t arena_allocator(arena_t *arena)
+{
+    allocator_t allocator = {
+        .alloc = arena_allocator_alloc,
+        .realloc = arena_allocator_realloc,
+        .free = NULL,
+        .context = arena
+    };
+
+    return allocator;
+}
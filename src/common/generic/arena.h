@@ -0,0 +1,125 @@
+/**
+ * @file arena.h
+ * @author Secareanu Filip
+ * @brief This module provides a bump-pointer arena allocator.
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ * An arena hands out memory by bumping a pointer inside large chunks and never
+ * frees individual blocks. Everything allocated from it is released at once,
+ * either completely with arena_reset or back to a saved point with
+ * arena_rewind. Chunks are kept and reused after a reset, so a steady
+ * workload stops touching the system allocator altogether.
+ *
+ * Containers can use an arena as their backing store through arena_allocator.
+ * A request-scoped list, stack or queue is then built on the arena and thrown
+ * away with a single reset, without destroying the container or freeing its
+ * elements one by one.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "memory_utils.h"
+
+#include <stddef.h>
+
+/**
+ * @brief A block of memory the arena bumps through.
+ */
+typedef struct arena_chunk arena_chunk_t;
+
+struct arena_chunk {
+    arena_chunk_t *next;                            ///< Next chunk, unused if this is the current one.
+    size_t capacity;                                ///< Usable bytes in the chunk.
+    size_t used;                                    ///< Bytes handed out so far.
+    _Alignas(max_align_t) unsigned char memory[];   ///< The memory handed out by the arena.
+};
+
+/**
+ * @brief The arena allocator.
+ */
+typedef struct arena arena_t;
+
+struct arena {
+    arena_chunk_t *first;       ///< First chunk of the arena.
+    arena_chunk_t *current;     ///< Chunk allocations are carved from; the chunks after it are unused.
+    size_t chunk_size;          ///< Default capacity of a new chunk.
+};
+
+/**
+ * @brief A saved position of the arena, see arena_mark and arena_rewind.
+ */
+typedef struct arena_mark {
+    arena_chunk_t *chunk;       ///< Current chunk when the mark was taken.
+    size_t used;                ///< Bytes used in that chunk when the mark was taken.
+} arena_mark_t;
+
+/**
+ * @brief Creates a new arena.
+ *
+ * @param chunk_size Capacity of each chunk; bigger requests get a chunk of their own.
+ * @return A pointer to the new arena.
+ */
+arena_t *arena_create(size_t chunk_size);
+
+/**
+ * @brief Frees the arena and all of its chunks.
+ *
+ * @param arena Pointer to the arena's pointer. Will set *arena to NULL after deallocation.
+ */
+void arena_destroy(arena_t **arena);
+
+/**
+ * @brief Allocates a block from the arena.
+ *
+ * The block is aligned for any type and lives until the arena is reset,
+ * rewound past it or destroyed.
+ *
+ * @param arena A pointer to the arena.
+ * @param size  Size in bytes of the block.
+ * @return A pointer to the block.
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * @brief Saves the current position of the arena.
+ *
+ * @param arena A pointer to the arena.
+ * @return The saved position.
+ */
+arena_mark_t arena_mark(arena_t *arena);
+
+/**
+ * @brief Releases everything allocated since the mark was taken.
+ *
+ * Marks taken after this one become invalid.
+ *
+ * @param arena A pointer to the arena.
+ * @param mark  A position previously returned by arena_mark.
+ */
+void arena_rewind(arena_t *arena, arena_mark_t mark);
+
+/**
+ * @brief Releases everything allocated from the arena in constant time.
+ *
+ * The chunks are kept for the next allocations.
+ *
+ * @param arena A pointer to the arena.
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * @brief Wraps the arena in the allocator interface used by the containers.
+ *
+ * The allocator has no free callback: containers built on it skip their
+ * per-element frees, and their memory comes back with the arena.
+ *
+ * @param arena A pointer to the arena.
+ * @return An allocator that allocates from the arena.
+ */
+allocator_t arena_allocator(arena_t *arena);
+
+#endif // ARENA_H
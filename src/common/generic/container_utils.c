@@ -11,9 +11,15 @@
 
 #include "container_utils.h"
 
+#include <stdint.h>
+
 #include "../../list/list.h"
+#include "../../list/unrolled_list.h"
+#include "../../list/skip_list.h"
 #include "../../stack/stack.h"
 #include "../../queue/queue.h"
+#include "../../hash_table/hash_table.h"
+#include "../../hash_table/swiss_map.h"
 
 container_error_t get_error(void *container, container_type_t type)
 {
@@ -30,9 +36,18 @@ container_error_t get_error(void *container, container_type_t type)
         case CONTAINER_QUEUE:
             error = ((queue_t *)container)->error;
             break;
-        // case CONTAINER_HASH_TABLE:
-        //     error = ((hash_table_t *)container)->error;
-        //     break;
+        case CONTAINER_UNROLLED_LIST:
+            error = ((ull_list_t *)container)->error;
+            break;
+        case CONTAINER_SKIP_LIST:
+            error = ((isl_list_t *)container)->error;
+            break;
+        case CONTAINER_HASH_TABLE:
+            error = ((hash_table_t *)container)->error;
+            break;
+        case CONTAINER_SWISS_MAP:
+            error = ((swiss_map_t *)container)->error;
+            break;
         default:
             error = ERROR_NONE;
             break;
@@ -40,3 +55,85 @@ container_error_t get_error(void *container, container_type_t type)
 
     return error;
 }
+
+size_t hash_bytes(const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    // Final avalanche, so the low bits depend on every input byte
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return (size_t)hash;
+}
+
+size_t growth_policy_grow(const growth_policy_t *policy, size_t capacity)
+{
+    size_t grown;
+
+    if (policy->growth_factor == GROWTH_FACTOR_1_5X) {
+        grown = capacity + capacity / 2;
+    } else {
+        grown = capacity * 2;
+    }
+
+    if (grown <= capacity) {
+        grown = capacity + 1;
+    }
+
+    return grown < policy->min_capacity ? policy->min_capacity : grown;
+}
+
+size_t growth_policy_shrink(const growth_policy_t *policy, size_t capacity, size_t floor)
+{
+    size_t shrunk;
+
+    if (policy->growth_factor == GROWTH_FACTOR_1_5X) {
+        shrunk = capacity - capacity / 3;
+    } else {
+        shrunk = capacity / 2;
+    }
+
+    return shrunk < floor ? floor : shrunk;
+}
+
+size_t growth_policy_grow_at(const growth_policy_t *policy, size_t capacity)
+{
+    double load = (double)policy->grow_treshold * (double)capacity;
+
+    if (load >= (double)capacity) {
+        return capacity;
+    }
+
+    // Rounded up, and always leaving room for at least one element
+    size_t limit = load > 0.0 ? (size_t)load : 0;
+
+    if ((double)limit < load) {
+        limit++;
+    }
+
+    return limit == 0 && capacity > 0 ? 1 : limit;
+}
+
+size_t growth_policy_shrink_below(const growth_policy_t *policy, size_t capacity, size_t shrunk_capacity)
+{
+    if (shrunk_capacity >= capacity) {
+        return 0;
+    }
+
+    double load = (double)policy->shrink_treshold * (double)capacity;
+    size_t limit = load > 0.0 ? (size_t)load + 1 : 1;
+    size_t hysteresis = growth_policy_grow_at(policy, shrunk_capacity) / 2;
+
+    return limit < hysteresis ? limit : hysteresis;
+}
@@ -15,6 +15,7 @@
 #include "../error/error.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /** 
  * @brief Enumeration of supported container types.
@@ -24,6 +25,9 @@ typedef enum container_type {
     CONTAINER_STACK,                /**< Represents a stack container. */
     CONTAINER_QUEUE,                /**< Represents a queue container. */
     CONTAINER_HASH_TABLE,           /**< Represents a hash table container. */
+    CONTAINER_UNROLLED_LIST,        /**< Represents an unrolled list container. */
+    CONTAINER_SKIP_LIST,            /**< Represents an indexable skip list container. */
+    CONTAINER_SWISS_MAP,            /**< Represents a SwissTable-style hash map container. */
     CONTAINER_INVALID_TYPE          /**< Represents an invalid or unrecognized container type. */
 } container_type_t;
 
@@ -43,6 +47,31 @@ typedef enum sort_order {
     SORT_DESCENDING                 /**< Sort in descending order. */
 } sort_order_t;
 
+/**
+ * @brief Factor by which a growth policy scales a container's capacity.
+ */
+typedef enum growth_factor {
+    GROWTH_FACTOR_2X,               /**< Capacity doubles when growing and halves when shrinking. */
+    GROWTH_FACTOR_1_5X              /**< Capacity grows by half and shrinks by a third. */
+} growth_factor_t;
+
+/**
+ * @brief How an array-backed container grows and shrinks with its load.
+ *
+ * A container grows once its load reaches grow_treshold, and shrinks once it
+ * falls to shrink_treshold. To keep a workload that hovers around one size
+ * from resizing back and forth, the shrink band is also capped so that right
+ * after a shrink the container is at most half as full as would make it grow
+ * again. Containers turn the policy into integer size limits whenever their
+ * capacity changes, so the operations themselves only compare integers.
+ */
+typedef struct growth_policy {
+    float grow_treshold;            /**< Load (0-1] at which the container grows. */
+    float shrink_treshold;          /**< Load [0-1) at or under which the container shrinks. */
+    growth_factor_t growth_factor;  /**< Factor applied to the capacity on each resize. */
+    size_t min_capacity;            /**< Capacity the container never shrinks under. */
+} growth_policy_t;
+
 /**
  * @brief Pointer to a function that frees allocated memory for container data.
  * @param data The data to be freed.
@@ -83,10 +112,20 @@ typedef bool (*find_function_t)(const void *data1, const void *data2);
  * @brief Pointer to a function that checks uniqueness of two data items.
  * @param data1 The first data item to check.
  * @param data2 The second data item to check.
- * @return true if the two data items are considered unique, false if they are duplicates.
+ * @return true if the two data items are duplicates, false if they are considered unique.
  */
 typedef bool (*unique_function_t)(const void *data1, const void *data2);
 
+/**
+ * @brief Pointer to a function that hashes a data item.
+ * 
+ * Data items considered equal must hash to the same value.
+ * 
+ * @param data The data item to hash.
+ * @return The hash of the data item.
+ */
+typedef size_t (*hash_function_t)(const void *data);
+
 /**
  * @brief Retrieves the error status for a given container type.
  * @param container Pointer to the container to check the error status for.
@@ -95,4 +134,59 @@ typedef bool (*unique_function_t)(const void *data1, const void *data2);
  */
 container_error_t get_error(void *container, container_type_t type);
 
+/**
+ * @brief Hashes a block of bytes.
+ * 
+ * All the bits of the result are well mixed, so it can be reduced to a table
+ * index by masking.
+ * 
+ * @param data The bytes to hash.
+ * @param size The number of bytes to hash.
+ * @return The hash of the bytes.
+ */
+size_t hash_bytes(const void *data, size_t size);
+
+/**
+ * @brief Computes the capacity a container grows to.
+ * @param policy The growth policy.
+ * @param capacity The current capacity.
+ * @return The next capacity, larger than capacity and at least the policy's minimum.
+ */
+size_t growth_policy_grow(const growth_policy_t *policy, size_t capacity);
+
+/**
+ * @brief Computes the capacity a container shrinks to.
+ * @param policy The growth policy.
+ * @param capacity The current capacity.
+ * @param floor The smallest capacity allowed.
+ * @return The previous capacity, never under floor.
+ */
+size_t growth_policy_shrink(const growth_policy_t *policy, size_t capacity, size_t floor);
+
+/**
+ * @brief Computes the size at which a container of the given capacity grows.
+ * 
+ * An insertion into a container holding at least this many elements must
+ * grow it first. The limit never exceeds the capacity.
+ * 
+ * @param policy The growth policy.
+ * @param capacity The current capacity.
+ * @return The growth limit.
+ */
+size_t growth_policy_grow_at(const growth_policy_t *policy, size_t capacity);
+
+/**
+ * @brief Computes the size under which a container of the given capacity shrinks to shrunk_capacity.
+ * 
+ * The limit is capped at half the growth limit of shrunk_capacity, so the
+ * shrunk container has room to grow by at least as much again before it
+ * resizes; in particular the element at index limit - 1 survives the shrink.
+ * 
+ * @param policy The growth policy.
+ * @param capacity The current capacity.
+ * @param shrunk_capacity The capacity the container would shrink to.
+ * @return The shrink limit, 0 if the container must not shrink.
+ */
+size_t growth_policy_shrink_below(const growth_policy_t *policy, size_t capacity, size_t shrunk_capacity);
+
 #endif // CONTAINER_UTILS_H
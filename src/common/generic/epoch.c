@@ -0,0 +1,206 @@
+/**
+ * @file epoch.c
+ * @author Secareanu Filip
+ * @brief This module implements epoch-based memory reclamation.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "epoch.h"
+
+#define EPOCH_ACTIVE ((uint64_t)1)
+
+static void epoch_bucket_free(epoch_thread_t *thread, epoch_bucket_t *bucket)
+{
+    for (size_t i = 0; i < bucket->count; i++) {
+        if (bucket->items[i].free_function != NULL) {
+            bucket->items[i].free_function(bucket->items[i].ptr);
+        } else {
+            free(bucket->items[i].ptr);
+        }
+    }
+
+    thread->pending -= bucket->count;
+    bucket->count = 0;
+}
+
+/*
+ * Advances the global epoch if every thread inside a critical section has
+ * already announced it.
+ */
+static void epoch_try_advance(epoch_domain_t *domain)
+{
+    uint64_t epoch = atomic_load_explicit(&domain->epoch, memory_order_seq_cst);
+
+    for (epoch_thread_t *thread = atomic_load_explicit(&domain->threads, memory_order_acquire); thread != NULL; thread = thread->next) {
+        uint64_t state = atomic_load_explicit(&thread->state, memory_order_acquire);
+
+        if ((state & EPOCH_ACTIVE) && (state >> 1) != epoch) {
+            return;
+        }
+    }
+
+    atomic_compare_exchange_strong_explicit(&domain->epoch, &epoch, epoch + 1, memory_order_acq_rel, memory_order_relaxed);
+}
+
+epoch_domain_t *epoch_domain_create(void)
+{
+    epoch_domain_t *domain = SAFE_CALLOC(1, sizeof(epoch_domain_t));
+
+    atomic_init(&domain->epoch, 0);
+    atomic_init(&domain->threads, NULL);
+
+    return domain;
+}
+
+void epoch_domain_destroy(epoch_domain_t **domain)
+{
+    if (*domain == NULL) {
+        return;
+    }
+
+    epoch_thread_t *thread = atomic_load_explicit(&(*domain)->threads, memory_order_acquire);
+
+    while (thread != NULL) {
+        epoch_thread_t *next = thread->next;
+
+        for (size_t i = 0; i < EPOCH_BUCKETS; i++) {
+            epoch_bucket_free(thread, &thread->buckets[i]);
+            free(thread->buckets[i].items);
+        }
+        free(thread);
+
+        thread = next;
+    }
+
+    free(*domain);
+    *domain = NULL;
+}
+
+epoch_thread_t *epoch_register(epoch_domain_t *domain)
+{
+    if (domain == NULL) {
+        return NULL;
+    }
+
+    // Reuse a released record first, so the list stays as short as the peak
+    // number of threads
+    for (epoch_thread_t *thread = atomic_load_explicit(&domain->threads, memory_order_acquire); thread != NULL; thread = thread->next) {
+        bool expected = false;
+
+        if (atomic_compare_exchange_strong_explicit(&thread->in_use, &expected, true, memory_order_acquire, memory_order_relaxed)) {
+            thread->nesting = 0;
+            return thread;
+        }
+    }
+
+    epoch_thread_t *thread = SAFE_CALLOC(1, sizeof(epoch_thread_t));
+
+    atomic_init(&thread->state, 0);
+    atomic_init(&thread->in_use, true);
+    thread->domain = domain;
+
+    epoch_thread_t *head = atomic_load_explicit(&domain->threads, memory_order_relaxed);
+
+    do {
+        thread->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&domain->threads, &head, thread, memory_order_release, memory_order_relaxed));
+
+    return thread;
+}
+
+void epoch_unregister(epoch_thread_t *thread)
+{
+    if (thread == NULL) {
+        return;
+    }
+
+    epoch_collect(thread);
+
+    // Pending blocks stay with the record until it is reused or the domain is destroyed
+    atomic_store_explicit(&thread->in_use, false, memory_order_release);
+}
+
+void epoch_enter(epoch_thread_t *thread)
+{
+    if (thread->nesting++ > 0) {
+        return;
+    }
+
+    uint64_t epoch = atomic_load_explicit(&thread->domain->epoch, memory_order_relaxed);
+
+    // Release, so a reclaimer that sees this announcement also sees the reads
+    // of the previous critical section as done
+    atomic_store_explicit(&thread->state, (epoch << 1) | EPOCH_ACTIVE, memory_order_release);
+
+    // The announcement must be visible before any shared node is read
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+void epoch_exit(epoch_thread_t *thread)
+{
+    if (--thread->nesting > 0) {
+        return;
+    }
+
+    uint64_t state = atomic_load_explicit(&thread->state, memory_order_relaxed);
+
+    atomic_store_explicit(&thread->state, state & ~EPOCH_ACTIVE, memory_order_release);
+}
+
+void epoch_retire(epoch_thread_t *thread, void *ptr, free_function_t free_function)
+{
+    if (thread == NULL || ptr == NULL) {
+        return;
+    }
+
+    // The block was unlinked before this point, so only threads that entered
+    // up to the current epoch can still hold it
+    atomic_thread_fence(memory_order_seq_cst);
+    uint64_t epoch = atomic_load_explicit(&thread->domain->epoch, memory_order_acquire);
+
+    epoch_bucket_t *bucket = &thread->buckets[epoch % EPOCH_BUCKETS];
+
+    // A bucket still holding an older epoch is at least EPOCH_BUCKETS epochs old
+    if (bucket->epoch != epoch) {
+        epoch_bucket_free(thread, bucket);
+        bucket->epoch = epoch;
+    }
+
+    if (bucket->count == bucket->capacity) {
+        bucket->capacity = bucket->capacity == 0 ? EPOCH_RETIRE_BATCH : bucket->capacity * 2;
+        bucket->items = SAFE_REALLOC(bucket->items, bucket->capacity * sizeof(epoch_retired_t));
+    }
+
+    bucket->items[bucket->count].ptr = ptr;
+    bucket->items[bucket->count].free_function = free_function;
+    bucket->count++;
+
+    thread->pending++;
+
+    if (thread->pending % EPOCH_RETIRE_BATCH == 0) {
+        epoch_collect(thread);
+    }
+}
+
+void epoch_collect(epoch_thread_t *thread)
+{
+    if (thread == NULL) {
+        return;
+    }
+
+    epoch_try_advance(thread->domain);
+
+    uint64_t epoch = atomic_load_explicit(&thread->domain->epoch, memory_order_acquire);
+
+    for (size_t i = 0; i < EPOCH_BUCKETS; i++) {
+        epoch_bucket_t *bucket = &thread->buckets[i];
+
+        if (bucket->count > 0 && bucket->epoch + 2 <= epoch) {
+            epoch_bucket_free(thread, bucket);
+        }
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file epoch.h
+ * @author Secareanu Filip
+ * @brief This module provides epoch-based memory reclamation for concurrent containers.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A lock-free container cannot free a node as soon as it unlinks it, because
+ * other threads may still be reading it. With epoch-based reclamation every
+ * thread wraps its accesses to the container in epoch_enter / epoch_exit, and
+ * unlinked nodes are handed to epoch_retire instead of being freed. Retired
+ * memory is released, in batches, once every thread has left the critical
+ * sections that could have seen it.
+ *
+ * The domain keeps a global epoch counter. A thread entering a critical
+ * section announces the epoch it observed; the epoch can only advance when
+ * every thread inside a critical section has announced the current one. A
+ * node retired during epoch e can therefore no longer be reached once the
+ * global epoch reaches e + 2. Each thread keeps its retired nodes in three
+ * buckets, one per epoch still in flight, and frees a whole bucket at a time
+ * through the free_function_t given at retirement.
+ *
+ * Reading a node costs two stores to a thread-private cache line and no
+ * reference counting; the price is that a thread stalled inside a critical
+ * section holds back reclamation for everybody.
+ */
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include "memory_utils.h"
+#include "container_utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Number of epochs a thread keeps retired memory for.
+ */
+#define EPOCH_BUCKETS 3
+
+/**
+ * @brief A thread tries to reclaim whenever its number of pending retirements reaches a multiple of this.
+ */
+#define EPOCH_RETIRE_BATCH 64
+
+/**
+ * @brief A block of memory waiting to be freed.
+ */
+typedef struct epoch_retired {
+    void *ptr;                          ///< The retired block.
+    free_function_t free_function;      ///< Function releasing the block, free() if NULL.
+} epoch_retired_t;
+
+/**
+ * @brief The blocks a thread retired during one epoch.
+ */
+typedef struct epoch_bucket {
+    epoch_retired_t *items;             ///< Retired blocks.
+    size_t count;                       ///< Number of retired blocks.
+    size_t capacity;                    ///< Number of blocks items has room for.
+    uint64_t epoch;                     ///< Epoch the blocks were retired in.
+} epoch_bucket_t;
+
+typedef struct epoch_domain epoch_domain_t;
+
+/**
+ * @brief The per-thread record of a domain, returned by epoch_register.
+ *
+ * Only state is shared with other threads; everything else is private to
+ * the thread that registered the record.
+ */
+typedef struct epoch_thread epoch_thread_t;
+
+struct epoch_thread {
+    _Atomic uint64_t state;             ///< Announced epoch shifted left by one, low bit set inside a critical section.
+    _Atomic bool in_use;                ///< Whether a thread currently owns the record.
+    epoch_thread_t *next;               ///< Next record of the domain.
+    epoch_domain_t *domain;             ///< Domain the record belongs to.
+    size_t nesting;                     ///< Depth of nested epoch_enter calls.
+    size_t pending;                     ///< Number of retired blocks not freed yet.
+    epoch_bucket_t buckets[EPOCH_BUCKETS];  ///< Retired blocks, indexed by epoch modulo EPOCH_BUCKETS.
+    unsigned char pad[CACHE_LINE_SIZE]; ///< Keeps the next record's state off this record's cache line.
+};
+
+/**
+ * @brief A reclamation domain, usually one per concurrent container.
+ */
+struct epoch_domain {
+    _Atomic uint64_t epoch;                     ///< The global epoch.
+    unsigned char pad[CACHE_LINE_SIZE];         ///< Keeps the epoch off the record list's cache line.
+    _Atomic(epoch_thread_t *) threads;          ///< Every record ever registered, records are reused but never removed.
+};
+
+/**
+ * @brief Creates a new reclamation domain.
+ *
+ * @return A pointer to the new domain.
+ */
+epoch_domain_t *epoch_domain_create(void);
+
+/**
+ * @brief Frees the domain, its thread records, and every block still pending.
+ *
+ * No thread may use the domain anymore.
+ *
+ * @param domain Pointer to the domain's pointer. Will set *domain to NULL after deallocation.
+ */
+void epoch_domain_destroy(epoch_domain_t **domain);
+
+/**
+ * @brief Registers the calling thread with the domain.
+ *
+ * A record released by epoch_unregister is reused, together with the blocks
+ * it still has pending.
+ *
+ * @param domain A pointer to the domain.
+ * @return The calling thread's record, to pass to the other functions.
+ */
+epoch_thread_t *epoch_register(epoch_domain_t *domain);
+
+/**
+ * @brief Releases the thread's record. The thread must not be inside a critical section.
+ *
+ * @param thread The record returned by epoch_register.
+ */
+void epoch_unregister(epoch_thread_t *thread);
+
+/**
+ * @brief Enters a critical section, in which the thread may read shared nodes.
+ *
+ * Critical sections can be nested; only the outermost one has an effect.
+ *
+ * @param thread The calling thread's record.
+ */
+void epoch_enter(epoch_thread_t *thread);
+
+/**
+ * @brief Leaves a critical section. Pointers read inside it must not be used anymore.
+ *
+ * @param thread The calling thread's record.
+ */
+void epoch_exit(epoch_thread_t *thread);
+
+/**
+ * @brief Schedules a block, already unlinked from the container, to be freed.
+ *
+ * The block is freed with free_function (or free() if NULL) once no thread
+ * can still be reading it. Every EPOCH_RETIRE_BATCH retirements the thread
+ * tries to reclaim.
+ *
+ * @param thread         The calling thread's record.
+ * @param ptr            The block to be freed.
+ * @param free_function  Function releasing the block, NULL for free().
+ */
+void epoch_retire(epoch_thread_t *thread, void *ptr, free_function_t free_function);
+
+/**
+ * @brief Tries to advance the global epoch and frees the thread's blocks that became safe.
+ *
+ * @param thread The calling thread's record.
+ */
+void epoch_collect(epoch_thread_t *thread);
+
+#endif // EPOCH_H
@@ -11,6 +11,8 @@
 
 #include "memory_utils.h"
 
+#include <stdatomic.h>
+
 void* safe_calloc(size_t nmemb, size_t size, unsigned int line) {
     void* ptr = calloc(nmemb, size);
     if (ptr == NULL) {
@@ -20,6 +22,15 @@ void* safe_calloc(size_t nmemb, size_t size, unsigned int line) {
     return ptr;
 }
 
+void* safe_malloc(size_t size, unsigned int line) {
+    void* ptr = malloc(size);
+    if (ptr == NULL) {
+        fprintf(stderr, "[%s:%u] Out of memory (%ld bytes)\n", __FILE__, line, size);
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
 void *safe_realloc(void *ptr, size_t size, unsigned int line)
 {
     void *new_ptr = realloc(ptr, size);
@@ -29,3 +40,155 @@ void *safe_realloc(void *ptr, size_t size, unsigned int line)
     }
     return new_ptr;
 }
+
+static void *default_alloc(void *context, size_t size)
+{
+    (void)context;
+
+    return malloc(size);
+}
+
+static void *default_realloc(void *context, void *ptr, size_t old_size, size_t new_size)
+{
+    (void)context;
+    (void)old_size;
+
+    return realloc(ptr, new_size);
+}
+
+static void default_free(void *context, void *ptr, size_t size)
+{
+    (void)context;
+    (void)size;
+
+    free(ptr);
+}
+
+static const allocator_t DEFAULT_ALLOCATOR = {
+    .alloc = default_alloc,
+    .realloc = default_realloc,
+    .free = default_free,
+    .context = NULL
+};
+
+const allocator_t *default_allocator(void)
+{
+    return &DEFAULT_ALLOCATOR;
+}
+
+void *allocator_alloc(const allocator_t *allocator, size_t size, unsigned int line)
+{
+    if (allocator == NULL) {
+        allocator = &DEFAULT_ALLOCATOR;
+    }
+
+    void *ptr = allocator->alloc(allocator->context, size);
+    if (ptr == NULL && size != 0) {
+        fprintf(stderr, "[%s:%u] Out of memory (%zu bytes)\n", __FILE__, line, size);
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+void *allocator_calloc(const allocator_t *allocator, size_t nmemb, size_t size, unsigned int line)
+{
+    // A wrapped product would hand out a short block as if it were full size
+    if (size != 0 && nmemb > SIZE_MAX / size) {
+        fprintf(stderr, "[%s:%u] Allocation size overflow (%zu x %zu bytes)\n", __FILE__, line, nmemb, size);
+        exit(EXIT_FAILURE);
+    }
+
+    void *ptr = allocator_alloc(allocator, nmemb * size, line);
+
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+void *allocator_realloc(const allocator_t *allocator, void *ptr, size_t old_size, size_t new_size, unsigned int line)
+{
+    if (allocator == NULL) {
+        allocator = &DEFAULT_ALLOCATOR;
+    }
+
+    if (ptr == NULL) {
+        return allocator_alloc(allocator, new_size, line);
+    }
+
+    if (allocator->realloc == NULL) {
+        void *new_ptr = allocator_alloc(allocator, new_size, line);
+
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+        allocator_free(allocator, ptr, old_size);
+
+        return new_ptr;
+    }
+
+    void *new_ptr = allocator->realloc(allocator->context, ptr, old_size, new_size);
+    if (new_ptr == NULL && new_size != 0) {
+        fprintf(stderr, "[%s:%u] Out of memory (%zu bytes)\n", __FILE__, line, new_size);
+        exit(EXIT_FAILURE);
+    }
+    return new_ptr;
+}
+
+void allocator_free(const allocator_t *allocator, void *ptr, size_t size)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    if (allocator == NULL) {
+        allocator = &DEFAULT_ALLOCATOR;
+    }
+
+    if (allocator->free != NULL) {
+        allocator->free(allocator->context, ptr, size);
+    }
+}
+
+void atomic_load_bytes(void *dest, const void *src, size_t size)
+{
+    unsigned char *out = dest;
+    const unsigned char *in = src;
+
+    if ((uintptr_t)in % sizeof(uint64_t) == 0) {
+        for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+            uint64_t word = atomic_load_explicit((const _Atomic uint64_t *)in, memory_order_relaxed);
+
+            memcpy(out, &word, sizeof(word));
+            in += sizeof(uint64_t);
+            out += sizeof(uint64_t);
+        }
+    }
+
+    for (; size > 0; size--) {
+        *out++ = atomic_load_explicit((const _Atomic unsigned char *)in, memory_order_relaxed);
+        in++;
+    }
+}
+
+void atomic_store_bytes(void *dest, const void *src, size_t size)
+{
+    unsigned char *out = dest;
+    const unsigned char *in = src;
+
+    // Split exactly like atomic_load_bytes, so both sides use the same access sizes
+    if ((uintptr_t)out % sizeof(uint64_t) == 0) {
+        for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+            uint64_t word;
+
+            memcpy(&word, in, sizeof(word));
+            atomic_store_explicit((_Atomic uint64_t *)out, word, memory_order_relaxed);
+            in += sizeof(uint64_t);
+            out += sizeof(uint64_t);
+        }
+    }
+
+    for (; size > 0; size--) {
+        atomic_store_explicit((_Atomic unsigned char *)out, *in, memory_order_relaxed);
+        out++;
+        in++;
+    }
+}
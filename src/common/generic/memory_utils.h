@@ -1,7 +1,7 @@
 /**
  * @file memory_utils.h
  * @author Secareanu Filip
- * @brief This module provides a safe wrapper for calloc.
+ * @brief This module provides safe allocation wrappers and the allocator interface.
  * @version 0.1
  * @date 2023-10-22
  * 
@@ -14,6 +14,34 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/**
+ * @brief Assumed size of a cache line, used to keep data written by different threads apart.
+ */
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @brief Allocator interface used by the containers for all their internal memory.
+ * 
+ * The size of a block is passed back on realloc and free, so allocators that do
+ * not keep per-block headers (arenas, pools) can still implement them. The
+ * realloc and free members are optional: without realloc a block is moved with
+ * alloc + memcpy + free, and without free blocks are never given back one by
+ * one (the memory is expected to be released all at once by the owner of the
+ * allocator).
+ */
+typedef struct allocator allocator_t;
+
+struct allocator {
+    void *(*alloc)(void *context, size_t size);                                     ///< Allocates size bytes, returns NULL on failure.
+    void *(*realloc)(void *context, void *ptr, size_t old_size, size_t new_size);   ///< Optional, resizes a block, returns NULL on failure.
+    void (*free)(void *context, void *ptr, size_t size);                            ///< Optional, releases a block.
+    void *context;                                                                  ///< User data passed to every call.
+};
 
 /**
  * @brief Allocates memory and checks if the allocation was successful.
@@ -24,9 +52,103 @@
  */
 void* safe_calloc(size_t nmemb, size_t size, unsigned int line);
 
+/**
+ * @brief Allocates uninitialized memory and checks if the allocation was successful.
+ * 
+ * Use this instead of safe_calloc when the memory is overwritten right away.
+ * 
+ * @param size The size of the memory to be allocated.
+ * @param line The line where the function was called.
+ * @return void* The pointer to the allocated memory.
+ */
+void* safe_malloc(size_t size, unsigned int line);
+
 void* safe_realloc(void *ptr, size_t size, unsigned int line);
 
+/**
+ * @brief Returns the allocator backed by malloc, realloc and free.
+ * 
+ * @return const allocator_t* The default allocator.
+ */
+const allocator_t *default_allocator(void);
+
+/**
+ * @brief Allocates memory through an allocator and checks if the allocation was successful.
+ * 
+ * @param allocator The allocator to use, NULL for the default allocator.
+ * @param size The size of the memory to be allocated.
+ * @param line The line where the function was called.
+ * @return void* The pointer to the allocated memory.
+ */
+void* allocator_alloc(const allocator_t *allocator, size_t size, unsigned int line);
+
+/**
+ * @brief Allocates zeroed memory through an allocator and checks if the allocation was successful.
+ * 
+ * Exits the program, as on an allocation failure, if nmemb * size overflows.
+ * 
+ * @param allocator The allocator to use, NULL for the default allocator.
+ * @param nmemb The number of elements to be allocated.
+ * @param size The size of an element.
+ * @param line The line where the function was called.
+ * @return void* The pointer to the allocated memory.
+ */
+void* allocator_calloc(const allocator_t *allocator, size_t nmemb, size_t size, unsigned int line);
+
+/**
+ * @brief Resizes a block through an allocator and checks if the allocation was successful.
+ * 
+ * @param allocator The allocator to use, NULL for the default allocator.
+ * @param ptr The block to be resized, may be NULL.
+ * @param old_size The current size of the block.
+ * @param new_size The requested size of the block.
+ * @param line The line where the function was called.
+ * @return void* The pointer to the resized memory.
+ */
+void* allocator_realloc(const allocator_t *allocator, void *ptr, size_t old_size, size_t new_size, unsigned int line);
+
+/**
+ * @brief Releases a block through an allocator.
+ * 
+ * @param allocator The allocator to use, NULL for the default allocator.
+ * @param ptr The block to be released, may be NULL.
+ * @param size The size of the block.
+ */
+void allocator_free(const allocator_t *allocator, void *ptr, size_t size);
+
+/**
+ * @brief Copies size bytes out of memory that other threads may be writing, using relaxed atomic loads.
+ * 
+ * For optimistic readers (seqlocks, work stealing) that validate the copy
+ * afterwards and throw it away if a writer got in between. The writer must
+ * use atomic_store_bytes on the same address and size, so the racing accesses
+ * are atomic on both sides and the copy is torn at worst, never undefined.
+ * Aligned 8-byte words are copied at once, the rest byte by byte.
+ * 
+ * @param dest The private buffer receiving the bytes.
+ * @param src The shared memory to read.
+ * @param size The number of bytes to copy.
+ */
+void atomic_load_bytes(void *dest, const void *src, size_t size);
+
+/**
+ * @brief Copies size bytes into memory that other threads may be reading, using relaxed atomic stores.
+ * 
+ * The counterpart of atomic_load_bytes. Publishing the bytes still takes a
+ * release store or fence by the caller.
+ * 
+ * @param dest The shared memory to write.
+ * @param src The private buffer holding the bytes.
+ * @param size The number of bytes to copy.
+ */
+void atomic_store_bytes(void *dest, const void *src, size_t size);
+
 #define SAFE_CALLOC(nmemb, size) safe_calloc(nmemb, size, __LINE__);
 #define SAFE_REALLOC(ptr, size) safe_realloc(ptr, size, __LINE__);
+#define SAFE_MALLOC(size) safe_malloc(size, __LINE__);
+
+#define ALLOCATOR_ALLOC(allocator, size) allocator_alloc(allocator, size, __LINE__)
+#define ALLOCATOR_CALLOC(allocator, nmemb, size) allocator_calloc(allocator, nmemb, size, __LINE__)
+#define ALLOCATOR_REALLOC(allocator, ptr, old_size, new_size) allocator_realloc(allocator, ptr, old_size, new_size, __LINE__)
 
 #endif // MEMORY_UTILS_H
@@ -0,0 +1,236 @@
+/**
+ * @file ws_deque.c
+ * @author Secareanu Filip
+ * @brief   This is the source file for the work-stealing deque implementation.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The memory orderings follow "Correct and Efficient Work-Stealing for Weak
+ * Memory Models" (Le, Pop, Cohen, Zappa Nardelli, 2013).
+ */
+
+#include "ws_deque.h"
+
+static ws_deque_array_t *ws_deque_array_create(ws_deque_t *deque, size_t capacity)
+{
+    ws_deque_array_t *array = ALLOCATOR_ALLOC(&deque->allocator, sizeof(ws_deque_array_t) + capacity * deque->data_size);
+
+    array->capacity = capacity;
+    array->previous = NULL;
+
+    return array;
+}
+
+static void *ws_deque_slot(ws_deque_t *deque, ws_deque_array_t *array, int64_t index)
+{
+    return array->data + ((size_t)index & (array->capacity - 1)) * deque->data_size;
+}
+
+/*
+ * Copies the live elements into an array twice as large and publishes it.
+ * Only the owner grows the deque, and thieves never write to an array, so
+ * the copy cannot race with anything that changes its contents.
+ */
+static ws_deque_array_t *ws_deque_grow(ws_deque_t *deque, ws_deque_array_t *array, int64_t top, int64_t bottom)
+{
+    ws_deque_array_t *new_array = ws_deque_array_create(deque, array->capacity * 2);
+
+    for (int64_t i = top; i < bottom; i++) {
+        memcpy(ws_deque_slot(deque, new_array, i), ws_deque_slot(deque, array, i), deque->data_size);
+    }
+
+    new_array->previous = array;
+
+    atomic_store_explicit(&deque->array, new_array, memory_order_release);
+
+    return new_array;
+}
+
+ws_deque_t *ws_deque_create(size_t data_size, size_t capacity, float grow_treshold, free_function_t free_function, print_function_t print_function)
+{
+    return ws_deque_create_a(data_size, capacity, grow_treshold, free_function, print_function, NULL);
+}
+
+ws_deque_t *ws_deque_create_a(size_t data_size, size_t capacity, float grow_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    ws_deque_t *deque;
+
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    deque = ALLOCATOR_CALLOC(allocator, 1, sizeof(ws_deque_t));
+
+    deque->allocator = *allocator;
+
+    deque->data_size = data_size;
+    deque->grow_treshold = grow_treshold;
+
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    atomic_init(&deque->array, ws_deque_array_create(deque, rounded));
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+
+    deque->free_function = free_function;
+    deque->print_function = print_function;
+
+    return deque;
+}
+
+void ws_deque_destroy(ws_deque_t **deque, container_flags_t flag)
+{
+    if (*deque == NULL) {
+        return;
+    }
+
+    ws_deque_array_t *array = atomic_load_explicit(&(*deque)->array, memory_order_acquire);
+
+    if (flag == CF_FREE_DATA && (*deque)->free_function != NULL) {
+        int64_t top = atomic_load_explicit(&(*deque)->top, memory_order_acquire);
+        int64_t bottom = atomic_load_explicit(&(*deque)->bottom, memory_order_acquire);
+
+        for (int64_t i = top; i < bottom; i++) {
+            (*deque)->free_function(ws_deque_slot(*deque, array, i));
+        }
+    }
+
+    allocator_t allocator = (*deque)->allocator;
+
+    while (array != NULL) {
+        ws_deque_array_t *previous = array->previous;
+
+        allocator_free(&allocator, array, sizeof(ws_deque_array_t) + array->capacity * (*deque)->data_size);
+        array = previous;
+    }
+
+    allocator_free(&allocator, *deque, sizeof(ws_deque_t));
+
+    *deque = NULL;
+}
+
+void ws_deque_push(ws_deque_t *deque, const void *data)
+{
+    if (deque == NULL || data == NULL) {
+        return;
+    }
+
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    ws_deque_array_t *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+    size_t size = (size_t)(bottom - top);
+
+    if (size + 1 > array->capacity || (float)size / (float)array->capacity >= deque->grow_treshold) {
+        array = ws_deque_grow(deque, array, top, bottom);
+    }
+
+    // A thief may still be copying the slot's previous element
+    atomic_store_bytes(ws_deque_slot(deque, array, bottom), data, deque->data_size);
+
+    // The element must be visible before a thief can see the new bottom
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+}
+
+bool ws_deque_pop(ws_deque_t *deque, void *data)
+{
+    if (deque == NULL || data == NULL) {
+        return false;
+    }
+
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    ws_deque_array_t *array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+    // Claim the bottom element first, then look at what thieves did
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    if (top == bottom) {
+        // Last element: race the thieves for it
+        bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+        if (!won) {
+            return false;
+        }
+    }
+
+    memcpy(data, ws_deque_slot(deque, array, bottom), deque->data_size);
+
+    return true;
+}
+
+bool ws_deque_steal(ws_deque_t *deque, void *data)
+{
+    if (deque == NULL || data == NULL) {
+        return false;
+    }
+
+    for (;;) {
+        int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+        if (top >= bottom) {
+            return false;
+        }
+
+        ws_deque_array_t *array = atomic_load_explicit(&deque->array, memory_order_acquire);
+
+        // The copy has to happen before the CAS: once top moves, the owner
+        // may reuse the slot. If another thread got the element first, the
+        // copy may be stale or torn, and it is thrown away with the failed
+        // CAS. Push writes slots with atomic stores, so this is no data race.
+        atomic_load_bytes(data, ws_deque_slot(deque, array, top), deque->data_size);
+
+        if (atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+size_t ws_deque_size(ws_deque_t *deque)
+{
+    if (deque == NULL) {
+        return 0;
+    }
+
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    return bottom > top ? (size_t)(bottom - top) : 0;
+}
+
+bool ws_deque_is_empty(ws_deque_t *deque)
+{
+    return ws_deque_size(deque) == 0;
+}
+
+void ws_deque_print(ws_deque_t *deque)
+{
+    if (deque == NULL || deque->print_function == NULL) {
+        return;
+    }
+
+    ws_deque_array_t *array = atomic_load_explicit(&deque->array, memory_order_acquire);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    for (int64_t i = top; i < bottom; i++) {
+        deque->print_function(ws_deque_slot(deque, array, i));
+    }
+}
@@ -0,0 +1,178 @@
+/**
+ * @file ws_deque.h
+ * @author Secareanu Filip
+ * @brief   This is the header file for the work-stealing deque implementation.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines a Chase-Lev work-stealing deque. One thread owns the
+ * deque and pushes and pops elements at its bottom, like a stack; any number
+ * of other threads steal the oldest elements from its top. The owner's
+ * operations only synchronize with thieves when the deque is down to its last
+ * element, and thieves only contend with each other through a compare-and-
+ * swap on the top index, so a scheduler built on one deque per worker spends
+ * almost no time on coordination.
+ *
+ * Elements follow the model of the rest of the library: the client provides
+ * their size and optional free and print functions, and the deque copies them
+ * in and out of a power-of-two circular array. Like stack_t, the array doubles
+ * once the load reaches the growth threshold. Growing never blocks thieves:
+ * the owner copies the live elements into a new array and publishes it with a
+ * single store, while thieves that still hold the old array keep reading valid
+ * (and identical) elements from it. Old arrays are kept until the deque is
+ * destroyed; since every array is twice the previous one, they never add up
+ * to more than the current array.
+ *
+ * A thief copies an element out before it knows whether it won it, so the
+ * copy may overlap the owner refilling that slot; a copy that lost is thrown
+ * away. To keep that overlap well-defined, pushes and steals move elements
+ * with relaxed atomic word accesses, which cost the same as plain ones on
+ * common hardware.
+ *
+ * Since several threads use the deque at once, operations report their
+ * outcome through their return value instead of a shared error field.
+ * Creation, destruction and printing are not thread-safe.
+ */
+
+#ifndef WS_DEQUE_H
+#define WS_DEQUE_H
+
+#include "../common/error/error.h"
+#include "../common/generic/memory_utils.h"
+#include "../common/generic/container_utils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/**
+ * @brief A circular array of elements. Arrays replaced by a bigger one stay chained through previous.
+ */
+typedef struct ws_deque_array ws_deque_array_t;
+
+struct ws_deque_array {
+    size_t capacity;                            ///< Number of slots, always a power of two.
+    ws_deque_array_t *previous;                 ///< Array this one replaced, freed with the deque.
+    _Alignas(max_align_t) unsigned char data[]; ///< The slots, data_size bytes each.
+};
+
+/**
+ * @brief The primary structure representing a work-stealing deque.
+ *
+ * The padding keeps the top index (written by thieves) and the bottom index
+ * (written by the owner) on different cache lines.
+ */
+typedef struct ws_deque ws_deque_t;
+
+struct ws_deque {
+    _Atomic(ws_deque_array_t *) array;  ///< Current circular array.
+    size_t data_size;                   ///< Size (in bytes) of the type of data this deque holds.
+    float grow_treshold;                ///< Capacity threshold for triggering growth.
+    free_function_t free_function;      ///< Optional custom function for data deallocation.
+    print_function_t print_function;    ///< Optional custom function for displaying deque data.
+    allocator_t allocator;              ///< Allocator used for the deque and its arrays.
+
+    unsigned char pad_shared[CACHE_LINE_SIZE];  ///< Separates the read-mostly fields from the top index.
+
+    _Atomic int64_t top;                ///< Index of the oldest element, advanced by thieves and by the owner's last pop.
+
+    unsigned char pad_top[CACHE_LINE_SIZE];     ///< Separates the top index from the bottom index.
+
+    _Atomic int64_t bottom;             ///< Index one past the newest element, written by the owner only.
+
+    unsigned char pad_bottom[CACHE_LINE_SIZE];  ///< Keeps the bottom index clear of whatever follows.
+};
+
+/**
+ * @brief Creates a new work-stealing deque.
+ *
+ * @param data_size        Size in bytes of the type of data the deque will hold.
+ * @param capacity         Initial capacity, rounded up to a power of two.
+ * @param grow_treshold    Percentage (0-1) to determine when the deque needs to expand.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying deque data.
+ * @return A pointer to the initialized deque.
+ */
+ws_deque_t *ws_deque_create(size_t data_size, size_t capacity, float grow_treshold, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Creates a new work-stealing deque that allocates through a custom allocator.
+ *
+ * @param data_size        Size in bytes of the type of data the deque will hold.
+ * @param capacity         Initial capacity, rounded up to a power of two.
+ * @param grow_treshold    Percentage (0-1) to determine when the deque needs to expand.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying deque data.
+ * @param allocator        Allocator copied into the deque, NULL for the default allocator.
+ * @return A pointer to the initialized deque.
+ */
+ws_deque_t *ws_deque_create_a(size_t data_size, size_t capacity, float grow_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Frees memory occupied by the deque. No thread may use the deque anymore.
+ *
+ * @param deque  Pointer to the deque's pointer. Will set *deque to NULL after deallocation.
+ * @param flag   Determines whether to free the stored data as well.
+ */
+void ws_deque_destroy(ws_deque_t **deque, container_flags_t flag);
+
+/**
+ * @brief Pushes a copy of an item at the bottom of the deque. Owner only.
+ *
+ * @param deque  A pointer to the deque.
+ * @param data   Pointer to the data item to push.
+ */
+void ws_deque_push(ws_deque_t *deque, const void *data);
+
+/**
+ * @brief Pops the newest item from the bottom of the deque into a caller buffer. Owner only.
+ *
+ * @param deque  A pointer to the deque.
+ * @param data   Buffer of at least data_size bytes receiving the item.
+ * @return true on success, false if the deque is empty (or a thief took the last item).
+ */
+bool ws_deque_pop(ws_deque_t *deque, void *data);
+
+/**
+ * @brief Steals the oldest item from the top of the deque into a caller buffer. Any thread.
+ *
+ * The item is copied before the compare-and-swap that claims it, so the copy
+ * can overlap the owner reusing the slot; such a copy is always discarded by
+ * the failing compare-and-swap. Both sides copy the slot with relaxed atomic
+ * accesses (atomic_load_bytes / atomic_store_bytes), so the overlap is no data
+ * race. The buffer may be written to even when the call fails.
+ *
+ * @param deque  A pointer to the deque.
+ * @param data   Buffer of at least data_size bytes receiving the item.
+ * @return true on success, false if the deque is empty.
+ */
+bool ws_deque_steal(ws_deque_t *deque, void *data);
+
+/**
+ * @brief Retrieves the number of items in the deque. Called while other threads are active, this is a snapshot.
+ *
+ * @param deque  A pointer to the deque.
+ * @return Number of items in the deque.
+ */
+size_t ws_deque_size(ws_deque_t *deque);
+
+/**
+ * @brief Checks if the deque is empty. Like ws_deque_size, this is a snapshot.
+ *
+ * @param deque  A pointer to the deque.
+ * @return true if the deque is empty, false otherwise.
+ */
+bool ws_deque_is_empty(ws_deque_t *deque);
+
+/**
+ * @brief Prints the content of the deque, top to bottom. Not safe while other threads are active.
+ *
+ * @param deque  A pointer to the deque.
+ */
+void ws_deque_print(ws_deque_t *deque);
+
+#endif // WS_DEQUE_H
@@ -0,0 +1,395 @@
+/**
+ * @file hash_table.c
+ * @author Secareanu Filip
+ * @brief   This is the source file for the hash table implementation.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "hash_table.h"
+
+#define HASH_TABLE_OCCUPIED ((size_t)1 << (sizeof(size_t) * 8 - 1))
+#define HASH_TABLE_MIN_CAPACITY 8
+#define HASH_TABLE_DEFAULT_LOAD_FACTOR 0.75f
+
+static size_t hash_table_hash(hash_table_t *hash_table, const void *key)
+{
+    size_t hash;
+
+    if (hash_table->hash_function != NULL) {
+        hash = hash_table->hash_function(key);
+    } else {
+        hash = hash_bytes(key, hash_table->key_size);
+    }
+
+    // The top bit tells occupied slots apart from empty ones
+    return hash | HASH_TABLE_OCCUPIED;
+}
+
+static size_t hash_table_home(hash_table_t *hash_table, size_t hash)
+{
+    // Fibonacci hashing, so weak user hashes still spread over the table
+    return (size_t)(((uint64_t)hash * 0x9E3779B97F4A7C15ULL) >> hash_table->shift);
+}
+
+static void *hash_table_entry(hash_table_t *hash_table, size_t slot)
+{
+    return hash_table->entries + slot * hash_table->entry_size;
+}
+
+static bool hash_table_equal(hash_table_t *hash_table, const void *key1, const void *key2)
+{
+    if (hash_table->equal_function != NULL) {
+        return hash_table->equal_function(key1, key2);
+    }
+
+    return memcmp(key1, key2, hash_table->key_size) == 0;
+}
+
+/*
+ * Returns the slot holding the key, or the empty slot that ends its probe
+ * sequence (where the key would be inserted).
+ */
+static size_t hash_table_probe(hash_table_t *hash_table, const void *key, size_t hash, bool *found)
+{
+    size_t mask = hash_table->capacity - 1;
+    size_t slot = hash_table_home(hash_table, hash);
+
+    while (hash_table->hashes[slot] != 0) {
+        if (hash_table->hashes[slot] == hash && hash_table_equal(hash_table, hash_table_entry(hash_table, slot), key)) {
+            *found = true;
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    *found = false;
+    return slot;
+}
+
+static size_t hash_table_capacity_for(size_t count, float max_load_factor)
+{
+    size_t capacity = HASH_TABLE_MIN_CAPACITY;
+
+    while ((float)capacity * max_load_factor < (float)count) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+static void hash_table_allocate(hash_table_t *hash_table, size_t capacity)
+{
+    unsigned int bits = 0;
+
+    while (((size_t)1 << bits) < capacity) {
+        bits++;
+    }
+
+    hash_table->hashes = ALLOCATOR_CALLOC(&hash_table->allocator, capacity, sizeof(size_t));
+    hash_table->entries = ALLOCATOR_ALLOC(&hash_table->allocator, capacity * hash_table->entry_size);
+
+    hash_table->capacity = capacity;
+    hash_table->shift = 64 - bits;
+
+    hash_table->grow_at = (size_t)((float)capacity * hash_table->max_load_factor);
+    if (hash_table->grow_at >= capacity) {
+        hash_table->grow_at = capacity - 1;
+    }
+}
+
+static void hash_table_rehash(hash_table_t *hash_table, size_t new_capacity)
+{
+    size_t *old_hashes = hash_table->hashes;
+    unsigned char *old_entries = hash_table->entries;
+    size_t old_capacity = hash_table->capacity;
+
+    hash_table_allocate(hash_table, new_capacity);
+
+    size_t mask = hash_table->capacity - 1;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_hashes[i] == 0) {
+            continue;
+        }
+
+        size_t slot = hash_table_home(hash_table, old_hashes[i]);
+        while (hash_table->hashes[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+
+        hash_table->hashes[slot] = old_hashes[i];
+        memcpy(hash_table_entry(hash_table, slot), old_entries + i * hash_table->entry_size, hash_table->entry_size);
+    }
+
+    allocator_free(&hash_table->allocator, old_hashes, old_capacity * sizeof(size_t));
+    allocator_free(&hash_table->allocator, old_entries, old_capacity * hash_table->entry_size);
+}
+
+hash_table_t *hash_table_create(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function)
+{
+    return hash_table_create_a(key_size, value_size, capacity, max_load_factor, hash_function, equal_function, free_function, print_function, NULL);
+}
+
+hash_table_t *hash_table_create_a(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    hash_table_t *hash_table;
+
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    hash_table = ALLOCATOR_CALLOC(allocator, 1, sizeof(hash_table_t));
+
+    hash_table->allocator = *allocator;
+
+    hash_table->key_size = key_size;
+    hash_table->value_size = value_size;
+    hash_table->value_offset = HASH_TABLE_VALUE_OFFSET(key_size);
+    hash_table->entry_size = (hash_table->value_offset + value_size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    hash_table->size = 0;
+
+    if (max_load_factor <= 0.0f || max_load_factor > 0.95f) {
+        max_load_factor = max_load_factor <= 0.0f ? HASH_TABLE_DEFAULT_LOAD_FACTOR : 0.95f;
+    }
+    hash_table->max_load_factor = max_load_factor;
+
+    hash_table_allocate(hash_table, hash_table_capacity_for(capacity, max_load_factor));
+
+    hash_table->hash_function = hash_function;
+    hash_table->equal_function = equal_function;
+
+    hash_table->error = ERROR_NONE;
+
+    hash_table->free_function = free_function;
+    hash_table->print_function = print_function;
+
+    return hash_table;
+}
+
+void hash_table_destroy(hash_table_t **hash_table, container_flags_t flag)
+{
+    if (*hash_table == NULL) {
+        return;
+    }
+
+    hash_table_clear(*hash_table, flag);
+
+    allocator_t allocator = (*hash_table)->allocator;
+
+    allocator_free(&allocator, (*hash_table)->hashes, (*hash_table)->capacity * sizeof(size_t));
+    allocator_free(&allocator, (*hash_table)->entries, (*hash_table)->capacity * (*hash_table)->entry_size);
+    allocator_free(&allocator, *hash_table, sizeof(hash_table_t));
+
+    *hash_table = NULL;
+}
+
+void hash_table_insert(hash_table_t *hash_table, const void *key, const void *value)
+{
+    if (hash_table == NULL) {
+        return;
+    }
+
+    if (key == NULL || (value == NULL && hash_table->value_size != 0)) {
+        hash_table->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    size_t hash = hash_table_hash(hash_table, key);
+    bool found;
+
+    size_t slot = hash_table_probe(hash_table, key, hash, &found);
+
+    if (!found) {
+        if (hash_table->size + 1 > hash_table->grow_at) {
+            hash_table_rehash(hash_table, hash_table->capacity * 2);
+            slot = hash_table_probe(hash_table, key, hash, &found);
+        }
+
+        hash_table->hashes[slot] = hash;
+        memcpy(hash_table_entry(hash_table, slot), key, hash_table->key_size);
+        hash_table->size++;
+    } else if (hash_table->free_function != NULL) {
+        // The entry is replaced as a whole, so whatever the old one owns is released
+        hash_table->free_function(hash_table_entry(hash_table, slot));
+        memcpy(hash_table_entry(hash_table, slot), key, hash_table->key_size);
+    }
+
+    if (hash_table->value_size != 0) {
+        memcpy((unsigned char *)hash_table_entry(hash_table, slot) + hash_table->value_offset, value, hash_table->value_size);
+    }
+
+    hash_table->error = ERROR_NONE;
+}
+
+void *hash_table_get(hash_table_t *hash_table, const void *key)
+{
+    if (hash_table == NULL) {
+        return NULL;
+    }
+
+    if (key == NULL) {
+        hash_table->error = ERROR_INVALID_DATA;
+        return NULL;
+    }
+
+    bool found;
+
+    size_t slot = hash_table_probe(hash_table, key, hash_table_hash(hash_table, key), &found);
+
+    if (!found) {
+        hash_table->error = ERROR_NOT_FOUND;
+        return NULL;
+    }
+
+    hash_table->error = ERROR_NONE;
+
+    return (unsigned char *)hash_table_entry(hash_table, slot) + hash_table->value_offset;
+}
+
+bool hash_table_contains(hash_table_t *hash_table, const void *key)
+{
+    if (hash_table == NULL) {
+        return false;
+    }
+
+    if (key == NULL) {
+        hash_table->error = ERROR_INVALID_DATA;
+        return false;
+    }
+
+    bool found;
+
+    hash_table_probe(hash_table, key, hash_table_hash(hash_table, key), &found);
+
+    hash_table->error = ERROR_NONE;
+
+    return found;
+}
+
+void hash_table_remove(hash_table_t *hash_table, const void *key)
+{
+    if (hash_table == NULL) {
+        return;
+    }
+
+    if (key == NULL) {
+        hash_table->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    bool found;
+
+    size_t hole = hash_table_probe(hash_table, key, hash_table_hash(hash_table, key), &found);
+
+    if (!found) {
+        hash_table->error = ERROR_NOT_FOUND;
+        return;
+    }
+
+    if (hash_table->free_function != NULL) {
+        hash_table->free_function(hash_table_entry(hash_table, hole));
+    }
+
+    // Backward-shift deletion: pull back every entry of the cluster that
+    // may live in the hole, so no tombstone is needed
+    size_t mask = hash_table->capacity - 1;
+    size_t slot = hole;
+
+    for (;;) {
+        slot = (slot + 1) & mask;
+
+        if (hash_table->hashes[slot] == 0) {
+            break;
+        }
+
+        size_t home = hash_table_home(hash_table, hash_table->hashes[slot]);
+
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            hash_table->hashes[hole] = hash_table->hashes[slot];
+            memcpy(hash_table_entry(hash_table, hole), hash_table_entry(hash_table, slot), hash_table->entry_size);
+            hole = slot;
+        }
+    }
+
+    hash_table->hashes[hole] = 0;
+    hash_table->size--;
+
+    hash_table->error = ERROR_NONE;
+}
+
+void hash_table_clear(hash_table_t *hash_table, container_flags_t flag)
+{
+    if (hash_table == NULL) {
+        return;
+    }
+
+    if (flag == CF_FREE_DATA && hash_table->free_function) {
+        for (size_t i = 0; i < hash_table->capacity; i++) {
+            if (hash_table->hashes[i] != 0) {
+                hash_table->free_function(hash_table_entry(hash_table, i));
+            }
+        }
+    }
+
+    memset(hash_table->hashes, 0, hash_table->capacity * sizeof(size_t));
+    hash_table->size = 0;
+
+    hash_table->error = ERROR_NONE;
+}
+
+void hash_table_reserve(hash_table_t *hash_table, size_t count)
+{
+    if (hash_table == NULL) {
+        return;
+    }
+
+    size_t capacity = hash_table_capacity_for(count, hash_table->max_load_factor);
+
+    if (capacity > hash_table->capacity) {
+        hash_table_rehash(hash_table, capacity);
+    }
+
+    hash_table->error = ERROR_NONE;
+}
+
+bool hash_table_is_empty(hash_table_t *hash_table)
+{
+    if (hash_table == NULL) {
+        return true;
+    }
+
+    return hash_table->size == 0;
+}
+
+size_t hash_table_size(hash_table_t *hash_table)
+{
+    if (hash_table == NULL) {
+        return 0;
+    }
+
+    return hash_table->size;
+}
+
+void hash_table_print(hash_table_t *hash_table)
+{
+    if (hash_table == NULL) {
+        return;
+    }
+
+    if (hash_table->print_function == NULL) {
+        hash_table->error = ERROR_INVALID_FUNCTION;
+        return;
+    }
+
+    for (size_t i = 0; i < hash_table->capacity; i++) {
+        if (hash_table->hashes[i] != 0) {
+            hash_table->print_function(hash_table_entry(hash_table, i));
+        }
+    }
+
+    hash_table->error = ERROR_NONE;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file hash_table.h
+ * @author Secareanu Filip
+ * @brief   This is the header file for the hash table implementation.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines the structure and function prototypes required to implement
+ * a generic hash table mapping fixed-size keys to fixed-size values. The table
+ * uses open addressing with linear probing over a single power-of-two array of
+ * slots, so a lookup usually ends within one or two cache lines. Removal uses
+ * backward-shift deletion instead of tombstones, which keeps probe sequences
+ * short no matter how many keys come and go.
+ *
+ * The table is designed to be generic: client code provides the size of the
+ * keys and values, and optionally a hash function, an equality function and
+ * custom memory management and printing functions. Without a hash or equality
+ * function keys are hashed and compared byte by byte.
+ *
+ * Every slot stores a key immediately followed, at HASH_TABLE_VALUE_OFFSET(key_size),
+ * by its value. The free and print functions receive a pointer to such an
+ * entry, so they can reach both halves of the pair.
+ *
+ * Error handling follows the rest of the library: the table keeps track of the
+ * last occurred error using the `container_error_t` type.
+ */
+
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include "../common/error/error.h"
+#include "../common/generic/memory_utils.h"
+#include "../common/generic/container_utils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Offset of the value inside an entry, for a given key size.
+ */
+#define HASH_TABLE_VALUE_OFFSET(key_size) (((key_size) + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *))
+
+/**
+ * @brief The primary structure representing a generic hash table.
+ */
+typedef struct hash_table hash_table_t;
+
+struct hash_table {
+    size_t *hashes;                     ///< Stored hash of every slot, 0 marks an empty slot.
+    unsigned char *entries;             ///< Key/value pairs, entry_size bytes per slot.
+    size_t key_size;                    ///< Size (in bytes) of the keys.
+    size_t value_size;                  ///< Size (in bytes) of the values.
+    size_t value_offset;                ///< Offset of the value inside an entry.
+    size_t entry_size;                  ///< Size (in bytes) of a slot in the entries array.
+    size_t size;                        ///< Current number of entries in the table.
+    size_t capacity;                    ///< Number of slots, always a power of two.
+    unsigned int shift;                 ///< 64 - log2(capacity), used to pick the home slot.
+    float max_load_factor;              ///< Load factor (0-1) above which the table grows.
+    size_t grow_at;                     ///< Number of entries that triggers the next growth.
+    hash_function_t hash_function;      ///< Optional custom function for hashing keys.
+    find_function_t equal_function;     ///< Optional custom function for comparing keys.
+    container_error_t error;            ///< Holds any error status related to the latest table operation.
+    free_function_t free_function;      ///< Optional custom function for entry deallocation.
+    print_function_t print_function;    ///< Optional custom function for displaying entries.
+    allocator_t allocator;              ///< Allocator used for the table and its arrays.
+};
+
+/**
+ * @brief Creates a new generic hash table instance.
+ *
+ * @param key_size         Size in bytes of the keys.
+ * @param value_size       Size in bytes of the values (may be 0 for a set).
+ * @param capacity         Number of entries the table should hold without growing.
+ * @param max_load_factor  Load factor (0-1) above which the table grows, 0 picks the default of 0.75.
+ * @param hash_function    Optional custom function for hashing keys.
+ * @param equal_function   Optional custom function for comparing keys.
+ * @param free_function    Optional custom function for entry deallocation.
+ * @param print_function   Optional custom function for displaying entries.
+ * @return A pointer to the initialized hash table.
+ */
+hash_table_t *hash_table_create(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Creates a new generic hash table instance that allocates through a custom allocator.
+ *
+ * @param key_size         Size in bytes of the keys.
+ * @param value_size       Size in bytes of the values (may be 0 for a set).
+ * @param capacity         Number of entries the table should hold without growing.
+ * @param max_load_factor  Load factor (0-1) above which the table grows, 0 picks the default of 0.75.
+ * @param hash_function    Optional custom function for hashing keys.
+ * @param equal_function   Optional custom function for comparing keys.
+ * @param free_function    Optional custom function for entry deallocation.
+ * @param print_function   Optional custom function for displaying entries.
+ * @param allocator        Allocator copied into the table, NULL for the default allocator.
+ * @return A pointer to the initialized hash table.
+ */
+hash_table_t *hash_table_create_a(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Frees memory occupied by the hash table.
+ *
+ * @param hash_table  Pointer to the table's pointer. Will set *hash_table to NULL after deallocation.
+ * @param flag        Determines whether to free the stored entries as well.
+ */
+void hash_table_destroy(hash_table_t **hash_table, container_flags_t flag);
+
+/**
+ * @brief Inserts a key/value pair, or overwrites the value if the key is already present.
+ *
+ * When the key is already present and there is a free function, the old
+ * entry is passed to it first and then replaced by the new key and value, so
+ * the container owns exactly what was inserted last. The new key and value
+ * must therefore not share anything the old entry owns. Without a free
+ * function only the value is overwritten.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @param key         Pointer to the key.
+ * @param value       Pointer to the value, may be NULL when value_size is 0.
+ */
+void hash_table_insert(hash_table_t *hash_table, const void *key, const void *value);
+
+/**
+ * @brief Looks up the value stored for a key.
+ *
+ * The returned pointer stays valid until the table is modified.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @param key         Pointer to the key.
+ * @return Pointer to the value, or NULL (with ERROR_NOT_FOUND) if the key is absent.
+ */
+void *hash_table_get(hash_table_t *hash_table, const void *key);
+
+/**
+ * @brief Checks if a key is present in the hash table.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @param key         Pointer to the key.
+ * @return true if the key is present, false otherwise.
+ */
+bool hash_table_contains(hash_table_t *hash_table, const void *key);
+
+/**
+ * @brief Removes a key and its value, applying the free function to the entry.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @param key         Pointer to the key.
+ */
+void hash_table_remove(hash_table_t *hash_table, const void *key);
+
+/**
+ * @brief Clears the hash table of all entries without destroying the table itself.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @param flag        Determines whether to free the stored entries as well.
+ */
+void hash_table_clear(hash_table_t *hash_table, container_flags_t flag);
+
+/**
+ * @brief Grows the table so it can hold count entries without rehashing.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @param count       The number of entries to make room for.
+ */
+void hash_table_reserve(hash_table_t *hash_table, size_t count);
+
+/**
+ * @brief Checks if the hash table is empty.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @return true if the table is empty, false otherwise.
+ */
+bool hash_table_is_empty(hash_table_t *hash_table);
+
+/**
+ * @brief Retrieves the number of entries in the hash table.
+ *
+ * @param hash_table  A pointer to the hash table.
+ * @return Number of entries in the table.
+ */
+size_t hash_table_size(hash_table_t *hash_table);
+
+/**
+ * @brief Prints the entries of the hash table, in no particular order.
+ *
+ * @param hash_table  A pointer to the hash table.
+ */
+void hash_table_print(hash_table_t *hash_table);
+
+#endif // HASH_TABLE_H
@@ -0,0 +1,549 @@
+/**
+ * @file swiss_map.c
+ * @author Secareanu Filip
+ * @brief   This is the source file for the SwissTable-style hash map implementation.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "swiss_map.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define SWISS_MAP_EMPTY ((int8_t)-128)      // 0b10000000
+#define SWISS_MAP_DELETED ((int8_t)-2)      // 0b11111110
+#define SWISS_MAP_DEFAULT_LOAD_FACTOR 0.875f
+
+/*
+ * Group scans. Each returns a mask with bit i set when control byte i of the
+ * group (starting at ctrl) matches.
+ */
+#if defined(__SSE2__)
+
+static uint32_t swiss_map_match(const int8_t *ctrl, int8_t h2)
+{
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+}
+
+static uint32_t swiss_map_match_empty(const int8_t *ctrl)
+{
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(SWISS_MAP_EMPTY)));
+}
+
+static uint32_t swiss_map_match_empty_or_deleted(const int8_t *ctrl)
+{
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+    // Only empty and deleted bytes have their sign bit set
+    return (uint32_t)_mm_movemask_epi8(group);
+}
+
+#else
+
+#define SWISS_MAP_LSBS 0x0101010101010101ULL
+#define SWISS_MAP_MSBS 0x8080808080808080ULL
+
+// Gathers the top bit of every byte into the low 8 bits
+static uint32_t swiss_map_pack(uint64_t bits)
+{
+    return (uint32_t)(((bits & SWISS_MAP_MSBS) * 0x02040810204081ULL) >> 56);
+}
+
+static uint32_t swiss_map_match(const int8_t *ctrl, int8_t h2)
+{
+    uint32_t mask = 0;
+
+    for (int half = 0; half < 2; half++) {
+        uint64_t group;
+        memcpy(&group, ctrl + half * 8, sizeof(group));
+
+        // Exact zero-byte detection on group ^ h2 (no false positives)
+        uint64_t x = group ^ (SWISS_MAP_LSBS * (uint8_t)h2);
+        uint64_t zero = ~(((x & ~SWISS_MAP_MSBS) + ~SWISS_MAP_MSBS) | x | ~SWISS_MAP_MSBS);
+
+        mask |= swiss_map_pack(zero) << (half * 8);
+    }
+
+    return mask;
+}
+
+static uint32_t swiss_map_match_empty(const int8_t *ctrl)
+{
+    uint32_t mask = 0;
+
+    for (int half = 0; half < 2; half++) {
+        uint64_t group;
+        memcpy(&group, ctrl + half * 8, sizeof(group));
+
+        // Empty is the only control byte with bit 7 set and bit 6 clear
+        mask |= swiss_map_pack(group & ~(group << 1)) << (half * 8);
+    }
+
+    return mask;
+}
+
+static uint32_t swiss_map_match_empty_or_deleted(const int8_t *ctrl)
+{
+    uint32_t mask = 0;
+
+    for (int half = 0; half < 2; half++) {
+        uint64_t group;
+        memcpy(&group, ctrl + half * 8, sizeof(group));
+
+        mask |= swiss_map_pack(group) << (half * 8);
+    }
+
+    return mask;
+}
+
+#endif
+
+static size_t swiss_map_hash(swiss_map_t *map, const void *key)
+{
+    uint64_t hash;
+
+    if (map->hash_function != NULL) {
+        hash = map->hash_function(key);
+    } else {
+        hash = hash_bytes(key, map->key_size);
+    }
+
+    // Mix, so the 7-bit tag and the probe start both depend on every bit
+    hash *= 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 32;
+
+    return (size_t)hash;
+}
+
+static int8_t swiss_map_h2(size_t hash)
+{
+    return (int8_t)(hash & 0x7F);
+}
+
+static size_t swiss_map_h1(size_t hash)
+{
+    return hash >> 7;
+}
+
+static void *swiss_map_entry(swiss_map_t *map, size_t slot)
+{
+    return map->entries + slot * map->entry_size;
+}
+
+static bool swiss_map_equal(swiss_map_t *map, const void *key1, const void *key2)
+{
+    if (map->equal_function != NULL) {
+        return map->equal_function(key1, key2);
+    }
+
+    return memcmp(key1, key2, map->key_size) == 0;
+}
+
+static void swiss_map_set_ctrl(swiss_map_t *map, size_t slot, int8_t value)
+{
+    map->ctrl[slot] = value;
+
+    // The first group is mirrored after the last slot, so groups can be
+    // loaded from any position without wrapping
+    if (slot < SWISS_MAP_GROUP_WIDTH) {
+        map->ctrl[map->capacity + slot] = value;
+    }
+}
+
+/*
+ * Number of slots that may be filled before the map grows: rounded up, at
+ * least one, and always leaving an EMPTY slot for probes to stop on.
+ */
+static size_t swiss_map_limit(swiss_map_t *map, size_t capacity)
+{
+    double load = (double)map->max_load_factor * (double)capacity;
+    size_t limit = (size_t)load;
+
+    if ((double)limit < load) {
+        limit++;
+    }
+
+    if (limit == 0) {
+        limit = 1;
+    }
+
+    return limit < capacity ? limit : capacity - 1;
+}
+
+static size_t swiss_map_find(swiss_map_t *map, const void *key, size_t hash, bool *found)
+{
+    size_t mask = map->capacity - 1;
+    size_t position = swiss_map_h1(hash) & mask;
+    size_t step = 0;
+    int8_t h2 = swiss_map_h2(hash);
+
+    for (;;) {
+        const int8_t *group = map->ctrl + position;
+
+        for (uint32_t match = swiss_map_match(group, h2); match != 0; match &= match - 1) {
+            size_t slot = (position + (size_t)__builtin_ctz(match)) & mask;
+
+            if (swiss_map_equal(map, swiss_map_entry(map, slot), key)) {
+                *found = true;
+                return slot;
+            }
+        }
+
+        if (swiss_map_match_empty(group) != 0) {
+            *found = false;
+            return SIZE_MAX;
+        }
+
+        // Triangular probing over groups visits every group once
+        step += SWISS_MAP_GROUP_WIDTH;
+        position = (position + step) & mask;
+    }
+}
+
+static size_t swiss_map_find_free(swiss_map_t *map, size_t hash)
+{
+    size_t mask = map->capacity - 1;
+    size_t position = swiss_map_h1(hash) & mask;
+    size_t step = 0;
+
+    for (;;) {
+        uint32_t match = swiss_map_match_empty_or_deleted(map->ctrl + position);
+
+        if (match != 0) {
+            return (position + (size_t)__builtin_ctz(match)) & mask;
+        }
+
+        step += SWISS_MAP_GROUP_WIDTH;
+        position = (position + step) & mask;
+    }
+}
+
+static size_t swiss_map_capacity_for(swiss_map_t *map, size_t count)
+{
+    size_t capacity = SWISS_MAP_GROUP_WIDTH;
+
+    while (swiss_map_limit(map, capacity) < count) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+static void swiss_map_allocate(swiss_map_t *map, size_t capacity)
+{
+    map->ctrl = ALLOCATOR_ALLOC(&map->allocator, capacity + SWISS_MAP_GROUP_WIDTH);
+    map->entries = ALLOCATOR_ALLOC(&map->allocator, capacity * map->entry_size);
+
+    memset(map->ctrl, SWISS_MAP_EMPTY, capacity + SWISS_MAP_GROUP_WIDTH);
+
+    map->capacity = capacity;
+    map->growth_left = swiss_map_limit(map, capacity);
+}
+
+static void swiss_map_rehash(swiss_map_t *map, size_t new_capacity)
+{
+    int8_t *old_ctrl = map->ctrl;
+    unsigned char *old_entries = map->entries;
+    size_t old_capacity = map->capacity;
+
+    swiss_map_allocate(map, new_capacity);
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] < 0) {
+            continue;
+        }
+
+        void *entry = old_entries + i * map->entry_size;
+        size_t hash = swiss_map_hash(map, entry);
+        size_t slot = swiss_map_find_free(map, hash);
+
+        swiss_map_set_ctrl(map, slot, swiss_map_h2(hash));
+        memcpy(swiss_map_entry(map, slot), entry, map->entry_size);
+    }
+
+    map->growth_left -= map->size;
+
+    allocator_free(&map->allocator, old_ctrl, old_capacity + SWISS_MAP_GROUP_WIDTH);
+    allocator_free(&map->allocator, old_entries, old_capacity * map->entry_size);
+}
+
+swiss_map_t *swiss_map_create(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function)
+{
+    return swiss_map_create_a(key_size, value_size, capacity, max_load_factor, hash_function, equal_function, free_function, print_function, NULL);
+}
+
+swiss_map_t *swiss_map_create_a(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    swiss_map_t *map;
+
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    map = ALLOCATOR_CALLOC(allocator, 1, sizeof(swiss_map_t));
+
+    map->allocator = *allocator;
+
+    map->key_size = key_size;
+    map->value_size = value_size;
+    map->value_offset = SWISS_MAP_VALUE_OFFSET(key_size);
+    map->entry_size = (map->value_offset + value_size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    map->size = 0;
+
+    if (max_load_factor <= 0.0f || max_load_factor > 0.95f) {
+        max_load_factor = max_load_factor <= 0.0f ? SWISS_MAP_DEFAULT_LOAD_FACTOR : 0.95f;
+    }
+    map->max_load_factor = max_load_factor;
+
+    swiss_map_allocate(map, swiss_map_capacity_for(map, capacity));
+
+    map->hash_function = hash_function;
+    map->equal_function = equal_function;
+
+    map->error = ERROR_NONE;
+
+    map->free_function = free_function;
+    map->print_function = print_function;
+
+    return map;
+}
+
+void swiss_map_destroy(swiss_map_t **map, container_flags_t flag)
+{
+    if (*map == NULL) {
+        return;
+    }
+
+    swiss_map_clear(*map, flag);
+
+    allocator_t allocator = (*map)->allocator;
+
+    allocator_free(&allocator, (*map)->ctrl, (*map)->capacity + SWISS_MAP_GROUP_WIDTH);
+    allocator_free(&allocator, (*map)->entries, (*map)->capacity * (*map)->entry_size);
+    allocator_free(&allocator, *map, sizeof(swiss_map_t));
+
+    *map = NULL;
+}
+
+void swiss_map_insert(swiss_map_t *map, const void *key, const void *value)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    if (key == NULL || (value == NULL && map->value_size != 0)) {
+        map->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    size_t hash = swiss_map_hash(map, key);
+    bool found;
+
+    size_t slot = swiss_map_find(map, key, hash, &found);
+
+    if (!found) {
+        slot = swiss_map_find_free(map, hash);
+
+        if (map->growth_left == 0 && map->ctrl[slot] == SWISS_MAP_EMPTY) {
+            // Mostly tombstones: clean up in place, otherwise grow
+            if (map->size < swiss_map_limit(map, map->capacity) / 2) {
+                swiss_map_rehash(map, map->capacity);
+            } else {
+                size_t capacity = swiss_map_capacity_for(map, map->size + 1);
+
+                swiss_map_rehash(map, capacity > map->capacity ? capacity : map->capacity * 2);
+            }
+            slot = swiss_map_find_free(map, hash);
+        }
+
+        if (map->ctrl[slot] == SWISS_MAP_EMPTY && map->growth_left > 0) {
+            map->growth_left--;
+        }
+
+        swiss_map_set_ctrl(map, slot, swiss_map_h2(hash));
+        memcpy(swiss_map_entry(map, slot), key, map->key_size);
+        map->size++;
+    } else if (map->free_function != NULL) {
+        // The entry is replaced as a whole, so whatever the old one owns is released
+        map->free_function(swiss_map_entry(map, slot));
+        memcpy(swiss_map_entry(map, slot), key, map->key_size);
+    }
+
+    if (map->value_size != 0) {
+        memcpy((unsigned char *)swiss_map_entry(map, slot) + map->value_offset, value, map->value_size);
+    }
+
+    map->error = ERROR_NONE;
+}
+
+void *swiss_map_get(swiss_map_t *map, const void *key)
+{
+    if (map == NULL) {
+        return NULL;
+    }
+
+    if (key == NULL) {
+        map->error = ERROR_INVALID_DATA;
+        return NULL;
+    }
+
+    bool found;
+
+    size_t slot = swiss_map_find(map, key, swiss_map_hash(map, key), &found);
+
+    if (!found) {
+        map->error = ERROR_NOT_FOUND;
+        return NULL;
+    }
+
+    map->error = ERROR_NONE;
+
+    return (unsigned char *)swiss_map_entry(map, slot) + map->value_offset;
+}
+
+bool swiss_map_contains(swiss_map_t *map, const void *key)
+{
+    if (map == NULL) {
+        return false;
+    }
+
+    if (key == NULL) {
+        map->error = ERROR_INVALID_DATA;
+        return false;
+    }
+
+    bool found;
+
+    swiss_map_find(map, key, swiss_map_hash(map, key), &found);
+
+    map->error = ERROR_NONE;
+
+    return found;
+}
+
+void swiss_map_remove(swiss_map_t *map, const void *key)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    if (key == NULL) {
+        map->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    bool found;
+
+    size_t slot = swiss_map_find(map, key, swiss_map_hash(map, key), &found);
+
+    if (!found) {
+        map->error = ERROR_NOT_FOUND;
+        return;
+    }
+
+    if (map->free_function != NULL) {
+        map->free_function(swiss_map_entry(map, slot));
+    }
+
+    // A probe only continues past a group with no empty byte. If the run of
+    // full or deleted bytes around the slot is shorter than a group, no probe
+    // can have gone through it, and the slot can become empty again.
+    size_t mask = map->capacity - 1;
+    uint32_t empty_before = swiss_map_match_empty(map->ctrl + ((slot - SWISS_MAP_GROUP_WIDTH) & mask));
+    uint32_t empty_after = swiss_map_match_empty(map->ctrl + slot);
+
+    if (empty_before != 0 && empty_after != 0
+            && (size_t)(__builtin_clz(empty_before) - 16) + (size_t)__builtin_ctz(empty_after) < SWISS_MAP_GROUP_WIDTH) {
+        swiss_map_set_ctrl(map, slot, SWISS_MAP_EMPTY);
+        map->growth_left++;
+    } else {
+        swiss_map_set_ctrl(map, slot, SWISS_MAP_DELETED);
+    }
+
+    map->size--;
+
+    map->error = ERROR_NONE;
+}
+
+void swiss_map_clear(swiss_map_t *map, container_flags_t flag)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    if (flag == CF_FREE_DATA && map->free_function) {
+        for (size_t i = 0; i < map->capacity; i++) {
+            if (map->ctrl[i] >= 0) {
+                map->free_function(swiss_map_entry(map, i));
+            }
+        }
+    }
+
+    memset(map->ctrl, SWISS_MAP_EMPTY, map->capacity + SWISS_MAP_GROUP_WIDTH);
+    map->size = 0;
+    map->growth_left = swiss_map_limit(map, map->capacity);
+
+    map->error = ERROR_NONE;
+}
+
+void swiss_map_reserve(swiss_map_t *map, size_t count)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    size_t capacity = swiss_map_capacity_for(map, count);
+
+    if (capacity > map->capacity) {
+        swiss_map_rehash(map, capacity);
+    }
+
+    map->error = ERROR_NONE;
+}
+
+bool swiss_map_is_empty(swiss_map_t *map)
+{
+    if (map == NULL) {
+        return true;
+    }
+
+    return map->size == 0;
+}
+
+size_t swiss_map_size(swiss_map_t *map)
+{
+    if (map == NULL) {
+        return 0;
+    }
+
+    return map->size;
+}
+
+void swiss_map_print(swiss_map_t *map)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    if (map->print_function == NULL) {
+        map->error = ERROR_INVALID_FUNCTION;
+        return;
+    }
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->ctrl[i] >= 0) {
+            map->print_function(swiss_map_entry(map, i));
+        }
+    }
+
+    map->error = ERROR_NONE;
+}
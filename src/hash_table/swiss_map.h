@@ -0,0 +1,193 @@
+/**
+ * @file swiss_map.h
+ * @author Secareanu Filip
+ * @brief   This is the header file for the SwissTable-style hash map implementation.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines a generic hash map tuned for lookups. Next to the array
+ * of key/value slots the map keeps one control byte per slot: the top bit
+ * tells empty and deleted slots apart from full ones, and full slots store
+ * seven bits of the key's hash. A lookup loads sixteen control bytes at once
+ * and compares them all against the hash tag in a couple of instructions
+ * (SSE2 when available, a portable SWAR version otherwise), so the keys
+ * themselves are only touched on a tag match and most lookups read a single
+ * cache line of control bytes plus the matching slot.
+ *
+ * Keys are compared with the same find_function_t used by the rest of the
+ * library, and hashed with a hash_function_t or byte by byte. Like in the
+ * hash table, every slot stores a key followed, at SWISS_MAP_VALUE_OFFSET(key_size),
+ * by its value, and the free and print functions receive a pointer to such an
+ * entry.
+ */
+
+#ifndef SWISS_MAP_H
+#define SWISS_MAP_H
+
+#include "../common/error/error.h"
+#include "../common/generic/memory_utils.h"
+#include "../common/generic/container_utils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Number of control bytes scanned at once.
+ */
+#define SWISS_MAP_GROUP_WIDTH 16
+
+/**
+ * @brief Offset of the value inside an entry, for a given key size.
+ */
+#define SWISS_MAP_VALUE_OFFSET(key_size) (((key_size) + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *))
+
+/**
+ * @brief The primary structure representing a SwissTable-style hash map.
+ */
+typedef struct swiss_map swiss_map_t;
+
+struct swiss_map {
+    int8_t *ctrl;                       ///< Control bytes, capacity + SWISS_MAP_GROUP_WIDTH of them (the tail mirrors the head).
+    unsigned char *entries;             ///< Key/value pairs, entry_size bytes per slot.
+    size_t key_size;                    ///< Size (in bytes) of the keys.
+    size_t value_size;                  ///< Size (in bytes) of the values.
+    size_t value_offset;                ///< Offset of the value inside an entry.
+    size_t entry_size;                  ///< Size (in bytes) of a slot in the entries array.
+    size_t size;                        ///< Current number of entries in the map.
+    size_t capacity;                    ///< Number of slots, a power of two of at least SWISS_MAP_GROUP_WIDTH.
+    size_t growth_left;                 ///< Number of empty slots that can still be filled before rehashing.
+    float max_load_factor;              ///< Load factor (0-1) above which the map grows.
+    hash_function_t hash_function;      ///< Optional custom function for hashing keys.
+    find_function_t equal_function;     ///< Optional custom function for comparing keys.
+    container_error_t error;            ///< Holds any error status related to the latest map operation.
+    free_function_t free_function;      ///< Optional custom function for entry deallocation.
+    print_function_t print_function;    ///< Optional custom function for displaying entries.
+    allocator_t allocator;              ///< Allocator used for the map and its arrays.
+};
+
+/**
+ * @brief Creates a new SwissTable-style hash map.
+ *
+ * @param key_size         Size in bytes of the keys.
+ * @param value_size       Size in bytes of the values (may be 0 for a set).
+ * @param capacity         Number of entries the map should hold without growing.
+ * @param max_load_factor  Load factor (0-1) above which the map grows, 0 picks the default of 0.875.
+ * @param hash_function    Optional custom function for hashing keys.
+ * @param equal_function   Optional custom function for comparing keys.
+ * @param free_function    Optional custom function for entry deallocation.
+ * @param print_function   Optional custom function for displaying entries.
+ * @return A pointer to the initialized map.
+ */
+swiss_map_t *swiss_map_create(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Creates a new SwissTable-style hash map that allocates through a custom allocator.
+ *
+ * @param key_size         Size in bytes of the keys.
+ * @param value_size       Size in bytes of the values (may be 0 for a set).
+ * @param capacity         Number of entries the map should hold without growing.
+ * @param max_load_factor  Load factor (0-1) above which the map grows, 0 picks the default of 0.875.
+ * @param hash_function    Optional custom function for hashing keys.
+ * @param equal_function   Optional custom function for comparing keys.
+ * @param free_function    Optional custom function for entry deallocation.
+ * @param print_function   Optional custom function for displaying entries.
+ * @param allocator        Allocator copied into the map, NULL for the default allocator.
+ * @return A pointer to the initialized map.
+ */
+swiss_map_t *swiss_map_create_a(size_t key_size, size_t value_size, size_t capacity, float max_load_factor, hash_function_t hash_function, find_function_t equal_function, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Frees memory occupied by the map.
+ *
+ * @param map   Pointer to the map's pointer. Will set *map to NULL after deallocation.
+ * @param flag  Determines whether to free the stored entries as well.
+ */
+void swiss_map_destroy(swiss_map_t **map, container_flags_t flag);
+
+/**
+ * @brief Inserts a key/value pair, or overwrites the value if the key is already present.
+ *
+ * When the key is already present and there is a free function, the old
+ * entry is passed to it first and then replaced by the new key and value, so
+ * the container owns exactly what was inserted last. The new key and value
+ * must therefore not share anything the old entry owns. Without a free
+ * function only the value is overwritten.
+ *
+ * @param map    A pointer to the map.
+ * @param key    Pointer to the key.
+ * @param value  Pointer to the value, may be NULL when value_size is 0.
+ */
+void swiss_map_insert(swiss_map_t *map, const void *key, const void *value);
+
+/**
+ * @brief Looks up the value stored for a key.
+ *
+ * The returned pointer stays valid until the map is modified.
+ *
+ * @param map  A pointer to the map.
+ * @param key  Pointer to the key.
+ * @return Pointer to the value, or NULL (with ERROR_NOT_FOUND) if the key is absent.
+ */
+void *swiss_map_get(swiss_map_t *map, const void *key);
+
+/**
+ * @brief Checks if a key is present in the map.
+ *
+ * @param map  A pointer to the map.
+ * @param key  Pointer to the key.
+ * @return true if the key is present, false otherwise.
+ */
+bool swiss_map_contains(swiss_map_t *map, const void *key);
+
+/**
+ * @brief Removes a key and its value, applying the free function to the entry.
+ *
+ * @param map  A pointer to the map.
+ * @param key  Pointer to the key.
+ */
+void swiss_map_remove(swiss_map_t *map, const void *key);
+
+/**
+ * @brief Clears the map of all entries without destroying the map itself.
+ *
+ * @param map   A pointer to the map.
+ * @param flag  Determines whether to free the stored entries as well.
+ */
+void swiss_map_clear(swiss_map_t *map, container_flags_t flag);
+
+/**
+ * @brief Grows the map so it can hold count entries without rehashing.
+ *
+ * @param map    A pointer to the map.
+ * @param count  The number of entries to make room for.
+ */
+void swiss_map_reserve(swiss_map_t *map, size_t count);
+
+/**
+ * @brief Checks if the map is empty.
+ *
+ * @param map  A pointer to the map.
+ * @return true if the map is empty, false otherwise.
+ */
+bool swiss_map_is_empty(swiss_map_t *map);
+
+/**
+ * @brief Retrieves the number of entries in the map.
+ *
+ * @param map  A pointer to the map.
+ * @return Number of entries in the map.
+ */
+size_t swiss_map_size(swiss_map_t *map);
+
+/**
+ * @brief Prints the entries of the map, in no particular order.
+ *
+ * @param map  A pointer to the map.
+ */
+void swiss_map_print(swiss_map_t *map);
+
+#endif // SWISS_MAP_H
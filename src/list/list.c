@@ -11,22 +11,742 @@
 
 #include "list.h"
 
+/**
+ * @brief The sublists of a dll_sort_parallel call, shared with the pool's tasks.
+ */
+typedef struct dll_sort_job {
+	dll_node_t *chains[DLL_SORT_PARALLEL_MAX_THREADS];	/**< The sublists, NULL terminated through next*/
+	dll_node_t *tails[DLL_SORT_PARALLEL_MAX_THREADS];	/**< The last node of every sublist*/
+	dll_node_t *halves[2];		/**< The two halves of the top merge, front one first*/
+	dll_node_t *ends[2];		/**< The last node of the front half and the first node of the back half*/
+	size_t front_count;			/**< The number of nodes the front half of the top merge takes*/
+	size_t back_count;			/**< The number of nodes the back half of the top merge takes*/
+	size_t count;				/**< The number of sublists*/
+	size_t width;				/**< The distance between the two sublists of a merge*/
+	compare_function_t compare_fn;	/**< The comparison function*/
+	sort_order_t order;			/**< The sort order*/
+} dll_sort_job_t;
+
+static bool dll_is_pooled(dll_list_t *list)
+{
+	return list->pool != NULL;
+}
+
+// Appends a slab of capacity cells after the current one and makes it current
+static void dll_pool_add_slab(dll_node_pool_t *pool, const allocator_t *allocator, size_t capacity)
+{
+	dll_slab_t *slab;
+
+	slab = ALLOCATOR_ALLOC(allocator, sizeof(dll_slab_t) + capacity * pool->cell_size);
+	slab->next = NULL;
+	slab->capacity = capacity;
+	slab->used = 0;
+
+	if (pool->current == NULL) {
+		pool->slabs = slab;
+	} else {
+		pool->current->next = slab;
+	}
+	pool->current = slab;
+}
+
+static dll_node_t *dll_pool_alloc(dll_node_pool_t *pool, const allocator_t *allocator)
+{
+	dll_node_t *node;
+
+	if (pool->free_list != NULL) {
+		node = pool->free_list;
+		pool->free_list = node->next;
+		return node;
+	}
+
+	if (pool->current == NULL || pool->current->used == pool->current->capacity) {
+		if (pool->current != NULL && pool->current->next != NULL) {
+			pool->current = pool->current->next;
+			pool->current->used = 0;
+		} else {
+			dll_pool_add_slab(pool, allocator, pool->slab_nodes);
+		}
+	}
+
+	node = (dll_node_t *)(pool->current->cells + pool->current->used * pool->cell_size);
+	pool->current->used++;
+
+	return node;
+}
+
+static void dll_pool_free(dll_node_pool_t *pool, dll_node_t *node)
+{
+	node->next = pool->free_list;
+	pool->free_list = node;
+}
+
+static void dll_pool_reset(dll_node_pool_t *pool)
+{
+	pool->free_list = NULL;
+	pool->current = pool->slabs;
+
+	if (pool->current != NULL) {
+		pool->current->used = 0;
+	}
+}
+
+static void dll_pool_release(dll_node_pool_t *pool, const allocator_t *allocator)
+{
+	dll_slab_t *slab;
+	dll_slab_t *next_slab;
+
+	slab = pool->slabs;
+
+	while (slab != NULL) {
+		next_slab = slab->next;
+		allocator_free(allocator, slab, sizeof(dll_slab_t) + slab->capacity * pool->cell_size);
+		slab = next_slab;
+	}
+
+	allocator_free(allocator, pool, sizeof(dll_node_pool_t));
+}
+
+static void dll_cursor_reset(dll_list_t *list)
+{
+	list->cursor_node = NULL;
+	list->cursor_index = 0;
+}
+
+static size_t dll_distance(size_t a, size_t b)
+{
+	return a > b ? a - b : b - a;
+}
+
+static dll_node_t *dll_node_at(dll_list_t *list, size_t index)
+{
+	dll_node_t *current_node;
+	size_t position;
+
+	// Walk from whichever of head, tail or the cached cursor is closest
+	current_node = list->head;
+	position = 0;
+
+	if (list->size - 1 - index < index) {
+		current_node = list->tail;
+		position = list->size - 1;
+	}
+
+	if (list->cursor_node != NULL && dll_distance(list->cursor_index, index) < dll_distance(position, index)) {
+		current_node = list->cursor_node;
+		position = list->cursor_index;
+	}
+
+	while (position < index) {
+		current_node = current_node->next;
+		position++;
+	}
+
+	while (position > index) {
+		current_node = current_node->prev;
+		position--;
+	}
+
+	list->cursor_node = current_node;
+	list->cursor_index = index;
+
+	return current_node;
+}
+
+static dll_node_t *dll_node_create(dll_list_t *list, const void *data)
+{
+	dll_node_t *new_node;
+
+	if (dll_is_pooled(list)) {
+		new_node = dll_pool_alloc(list->pool, &list->allocator);
+	} else {
+		new_node = ALLOCATOR_ALLOC(&list->allocator, sizeof(dll_node_t) + list->data_size);
+	}
+
+	new_node->next = NULL;
+	new_node->prev = NULL;
+	memcpy(new_node->data, data, list->data_size);
+
+	return new_node;
+}
+
+// Gives the node's memory back without touching its data
+static void dll_node_release(dll_list_t *list, dll_node_t *node)
+{
+	if (dll_is_pooled(list)) {
+		dll_pool_free(list->pool, node);
+	} else {
+		allocator_free(&list->allocator, node, sizeof(dll_node_t) + list->data_size);
+	}
+}
+
+static void dll_node_destroy(dll_list_t *list, dll_node_t *node)
+{
+	if (list->free_fn != NULL) {
+		list->free_fn(node->data);
+	}
+
+	dll_node_release(list, node);
+}
+
+static bool dll_in_order(const void *data1, const void *data2, compare_function_t compare_fn, sort_order_t order)
+{
+	int result;
+
+	result = compare_fn(data1, data2);
+
+	return order == SORT_DESCENDING ? result >= 0 : result <= 0;
+}
+
+/*
+ * Merges two sorted chains linked through next only. Ties are taken from
+ * the left chain, which keeps the merge stable.
+ */
+static dll_node_t *dll_merge_chains(dll_node_t *left, dll_node_t *right, compare_function_t compare_fn, sort_order_t order)
+{
+	dll_node_t *merged;
+	dll_node_t **tail;
+
+	merged = NULL;
+	tail = &merged;
+
+	while (left != NULL && right != NULL) {
+		if (dll_in_order(left->data, right->data, compare_fn, order)) {
+			*tail = left;
+			left = left->next;
+		} else {
+			*tail = right;
+			right = right->next;
+		}
+		tail = &(*tail)->next;
+	}
+
+	*tail = left != NULL ? left : right;
+
+	return merged;
+}
+
+/*
+ * Bottom-up merge sort of a NULL terminated chain. runs[i] holds a sorted
+ * run of 2^i nodes, so the sort needs no memory besides this fixed array.
+ */
+static dll_node_t *dll_sort_chain(dll_node_t *head, compare_function_t compare_fn, sort_order_t order)
+{
+	dll_node_t *runs[sizeof(size_t) * 8] = { NULL };
+	dll_node_t *current_node;
+	dll_node_t *run;
+	size_t i;
+
+	current_node = head;
+
+	while (current_node != NULL) {
+		run = current_node;
+		current_node = current_node->next;
+		run->next = NULL;
+
+		for (i = 0; runs[i] != NULL; i++) {
+			run = dll_merge_chains(runs[i], run, compare_fn, order);
+			runs[i] = NULL;
+		}
+		runs[i] = run;
+	}
+
+	run = NULL;
+
+	for (i = 0; i < sizeof(size_t) * 8; i++) {
+		if (runs[i] != NULL) {
+			run = dll_merge_chains(runs[i], run, compare_fn, order);
+		}
+	}
+
+	return run;
+}
+
+/*
+ * Restores the prev links of a chain linked through next only.
+ * Returns the last node of the chain.
+ */
+static dll_node_t *dll_relink_prev(dll_node_t *head)
+{
+	dll_node_t *prev_node;
+
+	prev_node = NULL;
+
+	for (dll_node_t *current_node = head; current_node != NULL; current_node = current_node->next) {
+		current_node->prev = prev_node;
+		prev_node = current_node;
+	}
+
+	return prev_node;
+}
+
+/*
+ * Like dll_merge_chains, for chains whose prev links are valid; the merged
+ * chain keeps them valid, so it never needs a dll_relink_prev pass.
+ */
+static dll_node_t *dll_merge_linked(dll_node_t *left, dll_node_t *right, compare_function_t compare_fn, sort_order_t order)
+{
+	dll_node_t *merged;
+	dll_node_t *last;
+
+	merged = NULL;
+	last = NULL;
+
+	while (left != NULL && right != NULL) {
+		dll_node_t *taken;
+
+		if (dll_in_order(left->data, right->data, compare_fn, order)) {
+			taken = left;
+			left = left->next;
+		} else {
+			taken = right;
+			right = right->next;
+		}
+
+		taken->prev = last;
+		if (last == NULL) {
+			merged = taken;
+		} else {
+			last->next = taken;
+		}
+		last = taken;
+	}
+
+	dll_node_t *rest = left != NULL ? left : right;
+
+	if (last == NULL) {
+		return rest;
+	}
+
+	last->next = rest;
+	if (rest != NULL) {
+		rest->prev = last;
+	}
+
+	return merged;
+}
+
+static void dll_sort_chains(size_t begin, size_t end, void *arg)
+{
+	dll_sort_job_t *job = arg;
+
+	for (size_t i = begin; i < end; i++) {
+		job->chains[i] = dll_sort_chain(job->chains[i], job->compare_fn, job->order);
+		job->tails[i] = dll_relink_prev(job->chains[i]);
+	}
+}
+
+/*
+ * Merge i of the current level joins the sublist at 2 * i * width with the
+ * one width slots after it, and leaves the result in the first slot. Ties go
+ * to the left sublist, so the merged tail is the right one's unless the left
+ * tail sorts strictly after it.
+ */
+static void dll_merge_level(size_t begin, size_t end, void *arg)
+{
+	dll_sort_job_t *job = arg;
+
+	for (size_t i = begin; i < end; i++) {
+		size_t left = 2 * i * job->width;
+		size_t right = left + job->width;
+
+		if (right < job->count) {
+			if (dll_in_order(job->tails[left]->data, job->tails[right]->data, job->compare_fn, job->order)) {
+				job->tails[left] = job->tails[right];
+			}
+
+			job->chains[left] = dll_merge_linked(job->chains[left], job->chains[right], job->compare_fn, job->order);
+		}
+	}
+}
+
+/*
+ * The top merge, split in two: piece 0 takes the front_count first nodes of
+ * the merged order walking forward from the heads, piece 1 the back_count
+ * last ones walking backward from the tails. Both break ties the way
+ * dll_merge_linked does, so the pieces take complementary sets of nodes, and
+ * each one only rewrites the links of the nodes it takes.
+ */
+static void dll_merge_top(size_t begin, size_t end, void *arg)
+{
+	dll_sort_job_t *job = arg;
+	size_t right_index = job->width;
+
+	for (size_t piece = begin; piece < end; piece++) {
+		dll_node_t *last = NULL;
+
+		if (piece == 0) {
+			dll_node_t *left = job->chains[0];
+			dll_node_t *right = job->chains[right_index];
+
+			for (size_t i = 0; i < job->front_count; i++) {
+				dll_node_t *taken;
+
+				if (right == NULL || (left != NULL && dll_in_order(left->data, right->data, job->compare_fn, job->order))) {
+					taken = left;
+					left = left->next;
+				} else {
+					taken = right;
+					right = right->next;
+				}
+
+				taken->prev = last;
+				if (last == NULL) {
+					job->halves[0] = taken;
+				} else {
+					last->next = taken;
+				}
+				last = taken;
+			}
+
+			job->ends[0] = last;
+		} else {
+			dll_node_t *left = job->tails[0];
+			dll_node_t *right = job->tails[right_index];
+
+			for (size_t i = 0; i < job->back_count; i++) {
+				dll_node_t *taken;
+
+				if (left == NULL || (right != NULL && dll_in_order(left->data, right->data, job->compare_fn, job->order))) {
+					taken = right;
+					right = right->prev;
+				} else {
+					taken = left;
+					left = left->prev;
+				}
+
+				taken->next = last;
+				if (last == NULL) {
+					job->halves[1] = taken;
+				} else {
+					last->prev = taken;
+				}
+				last = taken;
+			}
+
+			job->ends[1] = last;
+		}
+	}
+}
+
+static void dll_unlink(dll_list_t *list, dll_node_t *node)
+{
+	if (node->prev != NULL) {
+		node->prev->next = node->next;
+	} else {
+		list->head = node->next;
+	}
+
+	if (node->next != NULL) {
+		node->next->prev = node->prev;
+	} else {
+		list->tail = node->prev;
+	}
+}
+
+/*
+ * Nodes can move from one list to another as they are only when both lists
+ * take them from the same pool, or both allocate them one by one through the
+ * same allocator.
+ */
+static bool dll_nodes_movable(dll_list_t *dest, dll_list_t *src)
+{
+	if (dll_is_pooled(dest) || dll_is_pooled(src)) {
+		return dest->pool == src->pool;
+	}
+
+	return dest->allocator.alloc == src->allocator.alloc &&
+		dest->allocator.free == src->allocator.free &&
+		dest->allocator.context == src->allocator.context;
+}
+
+/*
+ * Unlinks the count nodes first..last from the list. The chain keeps its
+ * inner links, and last->next is set to NULL.
+ */
+static void dll_detach_chain(dll_list_t *list, dll_node_t *first, dll_node_t *last, size_t count)
+{
+	if (first->prev != NULL) {
+		first->prev->next = last->next;
+	} else {
+		list->head = last->next;
+	}
+
+	if (last->next != NULL) {
+		last->next->prev = first->prev;
+	} else {
+		list->tail = first->prev;
+	}
+
+	first->prev = NULL;
+	last->next = NULL;
+
+	list->size -= count;
+
+	dll_cursor_reset(list);
+}
+
+/*
+ * Turns a chain detached from src into one dest can own. Movable nodes are
+ * kept; otherwise every payload is copied into a node of dest and the old
+ * node is released to src, without its free function since the data moved.
+ * Returns the first node of the chain and stores the last one in *last.
+ */
+static dll_node_t *dll_adopt_chain(dll_list_t *dest, dll_list_t *src, dll_node_t *first, dll_node_t **last)
+{
+	if (dll_nodes_movable(dest, src)) {
+		return first;
+	}
+
+	dll_node_t *new_first;
+	dll_node_t *new_last;
+	dll_node_t *next_node;
+
+	new_first = NULL;
+	new_last = NULL;
+
+	for (dll_node_t *current_node = first; current_node != NULL; current_node = next_node) {
+		dll_node_t *new_node;
+
+		next_node = current_node->next;
+
+		new_node = dll_node_create(dest, current_node->data);
+		new_node->prev = new_last;
+
+		if (new_last != NULL) {
+			new_last->next = new_node;
+		} else {
+			new_first = new_node;
+		}
+		new_last = new_node;
+
+		dll_node_release(src, current_node);
+	}
+
+	*last = new_last;
+
+	return new_first;
+}
+
+// Links the chain first..last into the list in front of next_node, or at the end if it is NULL
+static void dll_link_chain(dll_list_t *list, dll_node_t *next_node, dll_node_t *first, dll_node_t *last, size_t count)
+{
+	dll_node_t *prev_node;
+
+	prev_node = next_node != NULL ? next_node->prev : list->tail;
+
+	first->prev = prev_node;
+	last->next = next_node;
+
+	if (prev_node != NULL) {
+		prev_node->next = first;
+	} else {
+		list->head = first;
+	}
+
+	if (next_node != NULL) {
+		next_node->prev = last;
+	} else {
+		list->tail = last;
+	}
+
+	list->size += count;
+
+	dll_cursor_reset(list);
+}
+
+typedef struct dll_unique_slot {
+	size_t hash;
+	dll_node_t *node;
+} dll_unique_slot_t;
+
+/*
+ * Removes the duplicates in one pass, remembering the first occurrence of
+ * every value in a linear probing set. Without a hash function the data is
+ * hashed and compared byte by byte. The set is scratch space freed right
+ * away, so it comes from the heap rather than the list's allocator, which
+ * may be an arena that would keep it until reset.
+ */
+static void dll_unique_hashed(dll_list_t *list, unique_function_t compare_fn, hash_function_t hash_fn)
+{
+	dll_unique_slot_t *slots;
+	dll_node_t *current_node;
+	dll_node_t *next_node;
+	size_t capacity;
+	unsigned int bits;
+
+	if (list->size <= 1) {
+		return;
+	}
+
+	bits = 1;
+	while (((size_t)1 << bits) < list->size * 2) {
+		bits++;
+	}
+	capacity = (size_t)1 << bits;
+
+	slots = ALLOCATOR_CALLOC(default_allocator(), capacity, sizeof(dll_unique_slot_t));
+
+	current_node = list->head;
+
+	while (current_node != NULL) {
+		size_t hash;
+		size_t i;
+
+		next_node = current_node->next;
+
+		hash = hash_fn != NULL ? hash_fn(current_node->data) : hash_bytes(current_node->data, list->data_size);
+
+		// Fibonacci hashing, so weak user hashes still spread over the table
+		i = (size_t)(((uint64_t)hash * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+
+		while (slots[i].node != NULL) {
+			if (slots[i].hash == hash) {
+				if (compare_fn != NULL ? compare_fn(slots[i].node->data, current_node->data)
+						: memcmp(slots[i].node->data, current_node->data, list->data_size) == 0) {
+					break;
+				}
+			}
+			i = (i + 1) & (capacity - 1);
+		}
+
+		if (slots[i].node != NULL) {
+			dll_unlink(list, current_node);
+			dll_node_destroy(list, current_node);
+
+			list->size--;
+		} else {
+			slots[i].hash = hash;
+			slots[i].node = current_node;
+		}
+
+		current_node = next_node;
+	}
+
+	allocator_free(default_allocator(), slots, capacity * sizeof(dll_unique_slot_t));
+
+	dll_cursor_reset(list);
+}
+
 dll_list_t *dll_create(size_t data_size, free_function_t free_fn, print_function_t print_fn)
+{
+	return dll_create_a(data_size, free_fn, print_fn, NULL);
+}
+
+dll_list_t *dll_create_a(size_t data_size, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator)
+{
+	dll_list_t *new_list;
+
+	if (allocator == NULL) {
+		allocator = default_allocator();
+	}
+	
+	new_list = ALLOCATOR_CALLOC(allocator, 1, sizeof(dll_list_t));
+	
+	new_list->allocator = *allocator;
+	
+	new_list->head = NULL;
+	new_list->tail = NULL;
+
+	new_list->data_size = data_size;
+	new_list->size = 0;
+
+	new_list->cursor_node = NULL;
+	new_list->cursor_index = 0;
+
+	new_list->free_fn = free_fn;
+	new_list->print_fn = print_fn;
+
+	new_list->error = ERROR_NONE;
+
+	return new_list;
+}
+
+dll_list_t *dll_from_array(size_t data_size, const void *array, size_t count, free_function_t free_fn, print_function_t print_fn)
+{
+	return dll_from_array_a(data_size, array, count, free_fn, print_fn, NULL);
+}
+
+dll_list_t *dll_from_array_a(size_t data_size, const void *array, size_t count, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator)
+{
+	dll_list_t *new_list;
+	dll_node_t *prev_node;
+
+	new_list = dll_create_pooled_a(data_size, count < DLL_FROM_ARRAY_SLAB_NODES ? count : DLL_FROM_ARRAY_SLAB_NODES, free_fn, print_fn, allocator);
+
+	if (array == NULL) {
+		new_list->error = count > 0 ? ERROR_INVALID_DATA : ERROR_NONE;
+		return new_list;
+	}
+
+	// The first slab is sized to the array, so all its nodes are carved out of one allocation
+	if (count > 0) {
+		dll_pool_add_slab(new_list->pool, &new_list->allocator, count);
+	}
+
+	prev_node = NULL;
+
+	for (size_t i = 0; i < count; i++) {
+		dll_node_t *new_node;
+
+		new_node = dll_node_create(new_list, (const unsigned char *)array + i * data_size);
+		new_node->prev = prev_node;
+
+		if (prev_node != NULL) {
+			prev_node->next = new_node;
+		} else {
+			new_list->head = new_node;
+		}
+		prev_node = new_node;
+	}
+
+	new_list->tail = prev_node;
+	new_list->size = count;
+
+	return new_list;
+}
+
+dll_list_t *dll_create_pooled(size_t data_size, size_t slab_nodes, free_function_t free_fn, print_function_t print_fn)
+{
+	return dll_create_pooled_a(data_size, slab_nodes, free_fn, print_fn, NULL);
+}
+
+dll_list_t *dll_create_pooled_a(size_t data_size, size_t slab_nodes, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator)
 {
 	dll_list_t *new_list;
-	
-	new_list = SAFE_CALLOC(sizeof(dll_list_t), 1);
-	
-	new_list->head = NULL;
-	new_list->tail = NULL;
+	size_t align;
 
-	new_list->data_size = data_size;
-	new_list->size = 0;
+	new_list = dll_create_a(data_size, free_fn, print_fn, allocator);
 
-	new_list->free_fn = free_fn;
-	new_list->print_fn = print_fn;
+	if (slab_nodes == 0) {
+		return new_list;
+	}
 
-	new_list->error = ERROR_NONE;
+	align = _Alignof(max_align_t);
+
+	new_list->pool = ALLOCATOR_CALLOC(&new_list->allocator, 1, sizeof(dll_node_pool_t));
+	new_list->pool->cell_size = (sizeof(dll_node_t) + data_size + align - 1) / align * align;
+	new_list->pool->slab_nodes = slab_nodes;
+	new_list->pool->owners = 1;
+
+	return new_list;
+}
+
+dll_list_t *dll_create_shared(dll_list_t *list)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	dll_list_t *new_list;
+
+	new_list = dll_create_a(list->data_size, list->free_fn, list->print_fn, &list->allocator);
+
+	new_list->pool = list->pool;
+
+	if (new_list->pool != NULL) {
+		new_list->pool->owners++;
+	}
 
 	return new_list;
 }
@@ -37,8 +757,16 @@ void dll_destroy(dll_list_t **list)
 		return;
 	}
 
+	allocator_t allocator;
+
+	allocator = (*list)->allocator;
+
 	dll_clear(*list);
-	free(*list);
+
+	if ((*list)->pool != NULL && --(*list)->pool->owners == 0) {
+		dll_pool_release((*list)->pool, &allocator);
+	}
+	allocator_free(&allocator, *list, sizeof(dll_list_t));
 
 	*list = NULL;
 }
@@ -88,12 +816,7 @@ void dll_append(dll_list_t *list, void *data)
 
 	dll_node_t *new_node;
 
-	new_node = SAFE_CALLOC(sizeof(dll_node_t), 1);
-
-	new_node->next = NULL;
-	new_node->prev = NULL;
-	new_node->data = SAFE_CALLOC(list->data_size, 1);
-	memcpy(new_node->data, data, list->data_size);
+	new_node = dll_node_create(list, data);
 
 	if (list->head == NULL) {
 		list->head = new_node;
@@ -122,12 +845,7 @@ void dll_prepend(dll_list_t *list, void *data)
 
 	dll_node_t *new_node;
 
-	new_node = SAFE_CALLOC(sizeof(dll_node_t), 1);
-
-	new_node->next = NULL;
-	new_node->prev = NULL;
-	new_node->data = SAFE_CALLOC(list->data_size, 1);
-	memcpy(new_node->data, data, list->data_size);
+	new_node = dll_node_create(list, data);
 
 	if (list->head == NULL) {
 		list->head = new_node;
@@ -140,6 +858,10 @@ void dll_prepend(dll_list_t *list, void *data)
 
 	list->size++;
 
+	if (list->cursor_node != NULL) {
+		list->cursor_index++;
+	}
+
 	list->error = ERROR_NONE;
 }
 
@@ -164,26 +886,12 @@ void dll_insert(dll_list_t *list, size_t index, void *data)
 		return;
 	}
 
-	if (index == list->size - 1) {
-		dll_append(list, data);
-		return;
-	}
-
 	dll_node_t *new_node;
 	dll_node_t *current_node;
 
-	new_node = SAFE_CALLOC(sizeof(dll_node_t), 1);
-
-	new_node->next = NULL;
-	new_node->prev = NULL;
-	new_node->data = SAFE_CALLOC(list->data_size, 1);
-	memcpy(new_node->data, data, list->data_size);
-
-	current_node = list->head;
+	current_node = dll_node_at(list, index);
 
-	for (size_t i = 0; i < index; i++) {
-		current_node = current_node->next;
-	}
+	new_node = dll_node_create(list, data);
 
 	new_node->next = current_node;
 	new_node->prev = current_node->prev;
@@ -193,6 +901,9 @@ void dll_insert(dll_list_t *list, size_t index, void *data)
 
 	list->size++;
 
+	list->cursor_node = new_node;
+	list->cursor_index = index;
+
 	list->error = ERROR_NONE;
 }
 
@@ -209,38 +920,31 @@ void dll_remove(dll_list_t *list, size_t index)
 
 	dll_node_t *to_delete;
 
-	if (index == 0) {
-		to_delete = list->head;
-
-		list->head = list->head->next;
-		list->head->prev = NULL;
-	} else if (index == list->size - 1) {
-		to_delete = list->tail;
+	to_delete = dll_node_at(list, index);
 
-		list->tail = list->tail->prev;
-		list->tail->next = NULL;
+	if (to_delete->prev != NULL) {
+		to_delete->prev->next = to_delete->next;
 	} else {
-		dll_node_t *current_node;
-
-		current_node = list->head;
-
-		for (size_t i = 0; i <= index; i++) {
-			current_node = current_node->next;
-		}
-
-		to_delete = current_node;
-
-		current_node->prev->next = current_node->next;
-		current_node->next->prev = current_node->prev;
+		list->head = to_delete->next;
 	}
 
-	if (list->free_fn != NULL) {
-		list->free_fn(to_delete->data);
+	if (to_delete->next != NULL) {
+		to_delete->next->prev = to_delete->prev;
+	} else {
+		list->tail = to_delete->prev;
 	}
-	if (to_delete->data != NULL) {
-		free(to_delete->data);
+
+	// The following node slides into the removed position
+	if (to_delete->next != NULL) {
+		list->cursor_node = to_delete->next;
+	} else if (to_delete->prev != NULL) {
+		list->cursor_node = to_delete->prev;
+		list->cursor_index = index - 1;
+	} else {
+		list->cursor_node = NULL;
 	}
-	free(to_delete);
+
+	dll_node_destroy(list, to_delete);
 
 	list->size--;
 
@@ -275,13 +979,7 @@ void dll_remove_if(dll_list_t *list, predicate_function_t predicate)
 				current_node->next->prev = current_node->prev;
 			}
 
-			if (list->free_fn != NULL) {
-				list->free_fn(current_node->data);
-			}
-			if (current_node->data != NULL) {
-				free(current_node->data);
-			}
-			free(current_node);
+			dll_node_destroy(list, current_node);
 
 			list->size--;
 		}
@@ -289,63 +987,40 @@ void dll_remove_if(dll_list_t *list, predicate_function_t predicate)
 		current_node = next_node;
 	}
 
+	dll_cursor_reset(list);
+
 	list->error = ERROR_NONE;
 }
 
-void dll_unique(dll_list_t *list) {
-    if (list == NULL) {
-        return;
-    }
-
-    dll_node_t *current_node;
-    dll_node_t *next_node;
-    dll_node_t *to_remove;
-
-    current_node = list->head;
-
-    while (current_node != NULL) {
-        next_node = current_node->next;
-
-        while (next_node != NULL) {
-            to_remove = next_node;
-
-            if (memcmp(current_node->data, to_remove->data, list->data_size) == 0) {
-                if (to_remove == list->tail) {
-                    list->tail = list->tail->prev;
-                    list->tail->next = NULL;
-                } else {
-                    to_remove->prev->next = to_remove->next;
-                    to_remove->next->prev = to_remove->prev;
-                }
-
-                next_node = to_remove->next;
-
-                if (list->free_fn != NULL) {
-                    list->free_fn(to_remove->data);
-                }
-                if (to_remove->data != NULL) {
-                    free(to_remove->data);
-                }
-                free(to_remove);
-
-                list->size--;
-            } else {
-                next_node = next_node->next;
-            }
-        }
+void dll_unique(dll_list_t *list)
+{
+	if (list == NULL) {
+		return;
+	}
 
-        current_node = current_node->next;
-    }
+	dll_unique_hashed(list, NULL, NULL);
 
-    list->error = ERROR_NONE;
+	list->error = ERROR_NONE;
 }
 
-void dll_unique_f(dll_list_t *list, unique_function_t compare_fn)
+void dll_unique_f(dll_list_t *list, unique_function_t compare_fn, hash_function_t hash_fn)
 {
 	if (list == NULL) {
 		return;
 	}
 
+	if (compare_fn == NULL) {
+		list->error = ERROR_INVALID_FUNCTION;
+		return;
+	}
+
+	if (hash_fn != NULL) {
+		dll_unique_hashed(list, compare_fn, hash_fn);
+
+		list->error = ERROR_NONE;
+		return;
+	}
+
 	dll_node_t *current_node;
 	dll_node_t *next_node;
 	dll_node_t *to_remove;
@@ -369,13 +1044,7 @@ void dll_unique_f(dll_list_t *list, unique_function_t compare_fn)
 
 				next_node = to_remove->next;
 
-				if (list->free_fn != NULL) {
-					list->free_fn(to_remove->data);
-				}
-				if (to_remove->data != NULL) {
-					free(to_remove->data);
-				}
-				free(to_remove);
+				dll_node_destroy(list, to_remove);
 
 				list->size--;
 			} else {
@@ -386,6 +1055,8 @@ void dll_unique_f(dll_list_t *list, unique_function_t compare_fn)
 		current_node = current_node->next;
 	}
 
+	dll_cursor_reset(list);
+
 	list->error = ERROR_NONE;
 }
 
@@ -395,23 +1066,29 @@ void dll_clear(dll_list_t *list)
 		return;
 	}
 
-	dll_node_t *current_node;
-	dll_node_t *next_node;
+	if (dll_is_pooled(list) && list->pool->owners == 1) {
+		if (list->free_fn != NULL) {
+			dll_node_t *current_node;
 
-	current_node = list->head;
+			for (current_node = list->head; current_node != NULL; current_node = current_node->next) {
+				list->free_fn(current_node->data);
+			}
+		}
 
-	while (current_node != NULL) {
-		next_node = current_node->next;
+		dll_pool_reset(list->pool);
+	} else if (dll_is_pooled(list) || list->free_fn != NULL || list->allocator.free != NULL) {
+		dll_node_t *current_node;
+		dll_node_t *next_node;
 
-		if (list->free_fn != NULL) {
-			list->free_fn(current_node->data);
-		}
-		if (current_node->data != NULL) {
-			free(current_node->data);
-		}
-		free(current_node);
+		current_node = list->head;
 
-		current_node = next_node;
+		while (current_node != NULL) {
+			next_node = current_node->next;
+
+			dll_node_destroy(list, current_node);
+
+			current_node = next_node;
+		}
 	}
 
 	list->head = NULL;
@@ -419,6 +1096,8 @@ void dll_clear(dll_list_t *list)
 
 	list->size = 0;
 
+	dll_cursor_reset(list);
+
 	list->error = ERROR_NONE;
 }
 
@@ -435,11 +1114,7 @@ void *dll_get(dll_list_t *list, size_t index)
 
 	dll_node_t *current_node;
 
-	current_node = list->head;
-
-	for (size_t i = 0; i < index; i++) {
-		current_node = current_node->next;
-	}
+	current_node = dll_node_at(list, index);
 
 	list->error = ERROR_NONE;
 
@@ -494,30 +1169,221 @@ size_t dll_find_f(dll_list_t *list, void *data, find_function_t find_fn)
 
 void dll_sort(dll_list_t *list, compare_function_t compare_fn, sort_order_t order)
 {
-	if (list == NULL || list->size <= 1) {
-        return;
-    }
+	if (list == NULL) {
+		return;
+	}
 
-    dll_node_t **array = SAFE_CALLOC(list->size, sizeof(dll_node_t*));
+	if (compare_fn == NULL) {
+		list->error = ERROR_INVALID_FUNCTION;
+		return;
+	}
 
-    dll_node_t *current = list->head;
-    for (size_t i = 0; i < list->size; i++) {
-        array[i] = current;
-        current = current->next;
-    }
+	if (list->size <= 1) {
+		list->error = ERROR_NONE;
+		return;
+	}
 
-    qsort(array, list->size, sizeof(dll_node_t*), (int (*)(const void*, const void*)) compare_fn);
+	list->head = dll_sort_chain(list->head, compare_fn, order);
+	list->tail = dll_relink_prev(list->head);
 
-    for (size_t i = 0; i < list->size - 1; i++) {
-        array[i]->next = array[i + 1];
-        array[i + 1]->prev = array[i];
-    }
-    list->head = array[0];
-    list->tail = array[list->size - 1];
-    list->head->prev = NULL;
-    list->tail->next = NULL;
+	dll_cursor_reset(list);
+
+	list->error = ERROR_NONE;
+}
+
+void dll_sort_parallel(dll_list_t *list, compare_function_t compare_fn, sort_order_t order, thread_pool_t *pool)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (compare_fn == NULL) {
+		list->error = ERROR_INVALID_FUNCTION;
+		return;
+	}
+
+	// The calling thread works as well, so there is one sublist per worker and one more
+	size_t thread_count = thread_pool_size(pool) + 1;
+
+	if (thread_count > DLL_SORT_PARALLEL_MAX_THREADS) {
+		thread_count = DLL_SORT_PARALLEL_MAX_THREADS;
+	}
+
+	if (thread_count > list->size / DLL_SORT_PARALLEL_MIN_NODES) {
+		thread_count = list->size / DLL_SORT_PARALLEL_MIN_NODES;
+	}
+
+	if (thread_count <= 1) {
+		dll_sort(list, compare_fn, order);
+		return;
+	}
+
+	dll_sort_job_t job;
+	dll_node_t *current_node;
+
+	job.count = thread_count;
+	job.compare_fn = compare_fn;
+	job.order = order;
+
+	// Cut the list into contiguous sublists, the first ones one node longer
+	current_node = list->head;
+
+	for (size_t i = 0; i < job.count; i++) {
+		size_t length = list->size / job.count + (i < list->size % job.count ? 1 : 0);
+
+		job.chains[i] = current_node;
+
+		for (size_t j = 1; j < length; j++) {
+			current_node = current_node->next;
+		}
+
+		dll_node_t *next_node = current_node->next;
+
+		current_node->next = NULL;
+		current_node = next_node;
+	}
+
+	parallel_for(pool, 0, job.count, 1, dll_sort_chains, &job);
+
+	// Sublists are merged with their right neighbour only, which keeps the
+	// sort stable. The top level is left for dll_merge_top
+	for (job.width = 1; 2 * job.width < job.count; job.width *= 2) {
+		size_t merges = (job.count + 2 * job.width - 1) / (2 * job.width);
+
+		parallel_for(pool, 0, merges, 1, dll_merge_level, &job);
+	}
+
+	job.front_count = list->size / 2;
+	job.back_count = list->size - job.front_count;
+
+	parallel_for(pool, 0, 2, 1, dll_merge_top, &job);
+
+	job.ends[0]->next = job.ends[1];
+	job.ends[1]->prev = job.ends[0];
+
+	// The merged tail, chosen the way dll_merge_level chooses it
+	list->tail = dll_in_order(job.tails[0]->data, job.tails[job.width]->data, compare_fn, order) ? job.tails[job.width] : job.tails[0];
+	list->head = job.halves[0];
+	list->head->prev = NULL;
+	list->tail->next = NULL;
+
+	dll_cursor_reset(list);
+
+	list->error = ERROR_NONE;
+}
+
+void dll_splice(dll_list_t *dest, size_t index, dll_list_t *src, size_t first, size_t count)
+{
+	if (dest == NULL || src == NULL) {
+		return;
+	}
+
+	if (dest == src || dest->data_size != src->data_size) {
+		dest->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	if (index > dest->size || first > src->size || count > src->size - first) {
+		dest->error = ERROR_INVALID_INDEX;
+		return;
+	}
+
+	if (count == 0) {
+		dest->error = ERROR_NONE;
+		return;
+	}
+
+	dll_node_t *first_node;
+	dll_node_t *last_node;
+	dll_node_t *next_node;
+
+	first_node = dll_node_at(src, first);
+	last_node = dll_node_at(src, first + count - 1);
+	next_node = index < dest->size ? dll_node_at(dest, index) : NULL;
+
+	dll_detach_chain(src, first_node, last_node, count);
+
+	first_node = dll_adopt_chain(dest, src, first_node, &last_node);
+
+	dll_link_chain(dest, next_node, first_node, last_node, count);
+
+	src->error = ERROR_NONE;
+	dest->error = ERROR_NONE;
+}
+
+void dll_concat(dll_list_t *dest, dll_list_t *src)
+{
+	if (dest == NULL || src == NULL) {
+		return;
+	}
+
+	dll_splice(dest, dest->size, src, 0, src->size);
+}
+
+dll_list_t *dll_split_at(dll_list_t *list, size_t index)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	if (index > list->size) {
+		list->error = ERROR_INVALID_INDEX;
+		return NULL;
+	}
+
+	dll_list_t *new_list;
+
+	new_list = dll_create_shared(list);
+
+	dll_splice(new_list, 0, list, index, list->size - index);
+
+	list->error = ERROR_NONE;
+
+	return new_list;
+}
+
+void dll_merge(dll_list_t *dest, dll_list_t *src, compare_function_t compare_fn, sort_order_t order)
+{
+	if (dest == NULL || src == NULL) {
+		return;
+	}
+
+	if (compare_fn == NULL) {
+		dest->error = ERROR_INVALID_FUNCTION;
+		return;
+	}
+
+	if (dest == src || dest->data_size != src->data_size) {
+		dest->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	if (src->size == 0) {
+		dest->error = ERROR_NONE;
+		return;
+	}
 
-    free(array);
+	dll_node_t *first_node;
+	dll_node_t *last_node;
+	size_t count;
+
+	count = src->size;
+	first_node = src->head;
+	last_node = src->tail;
+
+	dll_detach_chain(src, first_node, last_node, count);
+
+	first_node = dll_adopt_chain(dest, src, first_node, &last_node);
+
+	// Ties are taken from dest first, like the merges of dll_sort
+	dest->head = dll_merge_chains(dest->head, first_node, compare_fn, order);
+	dest->tail = dll_relink_prev(dest->head);
+	dest->size += count;
+
+	dll_cursor_reset(dest);
+
+	src->error = ERROR_NONE;
+	dest->error = ERROR_NONE;
 }
 
 void dll_reverse(dll_list_t *list)
@@ -543,6 +1409,10 @@ void dll_reverse(dll_list_t *list)
 	current_node = list->head;
 	list->head = list->tail;
 	list->tail = current_node;
+
+	if (list->cursor_node != NULL) {
+		list->cursor_index = list->size - 1 - list->cursor_index;
+	}
 }
 
 size_t dll_size(dll_list_t *list)
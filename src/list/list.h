@@ -20,6 +20,7 @@
 #include "../common/error/error.h"
 #include "../common/generic/container_utils.h"
 #include "../common/generic/memory_utils.h"
+#include "../scheduler/thread_pool.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -29,9 +30,26 @@
 #include <stdarg.h>
 #include <stdint.h>
 
+/**
+ * @brief Largest number of threads dll_sort_parallel splits a list between.
+ */
+#define DLL_SORT_PARALLEL_MAX_THREADS 64
+
+/**
+ * @brief Smallest number of nodes dll_sort_parallel hands to a thread; shorter lists are sorted by fewer threads.
+ */
+#define DLL_SORT_PARALLEL_MIN_NODES 4096
+
+/**
+ * @brief Largest slab dll_from_array gives the nodes added to a list after it is built.
+ */
+#define DLL_FROM_ARRAY_SLAB_NODES 1024
+
 /** 
  * @brief Node structure for the doubly linked list.
  * 
+ * The payload is stored inline, right after the links, so every node is a
+ * single allocation of sizeof(dll_node_t) + data_size bytes.
  */
 typedef struct dll_node dll_node_t;
 /**
@@ -39,11 +57,37 @@ typedef struct dll_node dll_node_t;
  * 
  */
 typedef struct dll_list dll_list_t;
+/**
+ * @brief A chunk of memory carved into fixed-size node cells.
+ * 
+ */
+typedef struct dll_slab dll_slab_t;
+/**
+ * @brief Optional node pool used by a list to recycle its nodes, possibly shared with other lists.
+ * 
+ */
+typedef struct dll_node_pool dll_node_pool_t;
 
 struct dll_node {
-    void *data;                 /**< The data held by the node*/
     dll_node_t *next;           /**< The next node in the list*/
     dll_node_t *prev;           /**< The previous node in the list*/
+    _Alignas(max_align_t) unsigned char data[];  /**< The data held by the node (data_size bytes)*/
+};
+
+struct dll_slab {
+    dll_slab_t *next;           /**< The next slab in the pool*/
+    size_t capacity;            /**< The number of cells in the slab*/
+    size_t used;                /**< The number of cells carved so far*/
+    _Alignas(max_align_t) unsigned char cells[];  /**< The cells (capacity * cell_size bytes)*/
+};
+
+struct dll_node_pool {
+    dll_slab_t *slabs;          /**< The first slab of the pool*/
+    dll_slab_t *current;        /**< The slab new cells are carved from; the slabs after it are unused*/
+    dll_node_t *free_list;      /**< Recycled cells, chained through their next link*/
+    size_t cell_size;           /**< The size of a node plus its payload, rounded for alignment*/
+    size_t slab_nodes;          /**< The number of cells in a new slab*/
+    size_t owners;              /**< The number of lists sharing the pool*/
 };
 
 struct dll_list {
@@ -53,10 +97,16 @@ struct dll_list {
     size_t data_size;           /**< The size of the data held by the list*/
     size_t size;                /**< The size of the list*/
 
+    dll_node_t *cursor_node;    /**< The last node accessed by index, NULL if unknown*/
+    size_t cursor_index;        /**< The index of the cursor node*/
+
     container_error_t error;    /**< The error code of the last operation*/
 
     free_function_t free_fn;    /**< The custom free function*/
     print_function_t print_fn;  /**< The custom print function*/
+
+    dll_node_pool_t *pool;      /**< The node pool, NULL unless the list was created pooled*/
+    allocator_t allocator;      /**< The allocator used for the list, its nodes and its slabs*/
 };
 
 /**
@@ -69,6 +119,86 @@ struct dll_list {
  */
 dll_list_t *dll_create(size_t data_size, free_function_t free_fn, print_function_t print_fn);
 
+/**
+ * @brief Creates a new doubly linked list that allocates through a custom allocator.
+ * 
+ * @param data_size The size of the data held by the list.
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @param allocator The allocator (copied into the list), NULL for the default allocator.
+ * @return dll_list_t* The newly created list.
+ */
+dll_list_t *dll_create_a(size_t data_size, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator);
+
+/**
+ * @brief Creates a new doubly linked list whose nodes come from a node pool.
+ * 
+ * Nodes are carved out of slabs of slab_nodes cells and recycled through a
+ * free list instead of going back to the system allocator. Clearing a pooled
+ * list without a free function takes constant time, as long as no other list
+ * shares its pool.
+ * 
+ * @param data_size The size of the data held by the list.
+ * @param slab_nodes The number of nodes allocated at once, 0 disables pooling.
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @return dll_list_t* The newly created list.
+ */
+dll_list_t *dll_create_pooled(size_t data_size, size_t slab_nodes, free_function_t free_fn, print_function_t print_fn);
+
+/**
+ * @brief Creates a new pooled doubly linked list whose slabs come from a custom allocator.
+ * 
+ * @param data_size The size of the data held by the list.
+ * @param slab_nodes The number of nodes allocated at once, 0 disables pooling.
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @param allocator The allocator (copied into the list), NULL for the default allocator.
+ * @return dll_list_t* The newly created list.
+ */
+dll_list_t *dll_create_pooled_a(size_t data_size, size_t slab_nodes, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator);
+
+/**
+ * @brief Creates a list holding copies of the elements of an array, in order.
+ * 
+ * The list is pooled, and its first slab holds exactly count nodes, so all
+ * the nodes are built in a single allocation. Nodes added later come from
+ * slabs of at most DLL_FROM_ARRAY_SLAB_NODES nodes.
+ * 
+ * @param data_size The size of the data held by the list.
+ * @param array The elements, count * data_size bytes.
+ * @param count The number of elements.
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @return dll_list_t* The newly created list.
+ */
+dll_list_t *dll_from_array(size_t data_size, const void *array, size_t count, free_function_t free_fn, print_function_t print_fn);
+
+/**
+ * @brief Creates a list holding copies of the elements of an array, allocating through a custom allocator.
+ * 
+ * @param data_size The size of the data held by the list.
+ * @param array The elements, count * data_size bytes.
+ * @param count The number of elements.
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @param allocator The allocator (copied into the list), NULL for the default allocator.
+ * @return dll_list_t* The newly created list.
+ */
+dll_list_t *dll_from_array_a(size_t data_size, const void *array, size_t count, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator);
+
+/**
+ * @brief Creates an empty list like list, sharing its node pool if it has one.
+ * 
+ * The new list has the same data size, functions and allocator. Lists that
+ * share a pool can pass nodes to each other by relinking them (see
+ * dll_splice), and the pool is released with the last of them.
+ * 
+ * @param list The list to copy the settings of.
+ * @return dll_list_t* The newly created list, NULL if list is NULL.
+ */
+dll_list_t *dll_create_shared(dll_list_t *list);
+
 /**
  * @brief Destroys the list and frees all the memory.
  * 
@@ -135,16 +265,28 @@ void dll_remove_if(dll_list_t *list, predicate_function_t predicate);
 
 /**
  * @brief Removes duplicate nodes from the list.
+ * 
+ * Nodes are compared byte by byte over data_size. The first occurrence of
+ * every value is kept, in O(n) expected time using a temporary hash set
+ * allocated from the heap, never from the list's allocator.
+ * 
  * @param list The list to remove duplicates from.
  */
 void dll_unique(dll_list_t *list);
 
 /**
  * @brief Removes duplicate nodes based on a custom comparison function.
+ * 
+ * The first occurrence of every value is kept. With a hash function the
+ * duplicates are found in O(n) expected time using a temporary hash set
+ * allocated from the heap, never from the list's allocator; without one every
+ * pair of nodes is compared in O(n^2).
+ * 
  * @param list The list to remove duplicates from.
- * @param compare_fn Function pointer to compare nodes.
+ * @param compare_fn Function pointer returning true when two nodes are duplicates.
+ * @param hash_fn Function pointer hashing a node consistently with compare_fn, or NULL.
  */
-void dll_unique_f(dll_list_t *list, unique_function_t compare_fn);
+void dll_unique_f(dll_list_t *list, unique_function_t compare_fn, hash_function_t hash_fn);
 
 /**
  * @brief Retrieves data at a specific index from the list.
@@ -157,6 +299,10 @@ void dll_clear(dll_list_t *list);
 
 /**
  * @brief Retrieves data at a specific index from the list.
+ * 
+ * The walk starts from the closest of the head, the tail and the last node
+ * accessed by index, so sequential access is O(1) amortized.
+ * 
  * @param list The list to retrieve data from.
  * @param index The index to retrieve data from.
  * @return Data at the specified index.
@@ -182,12 +328,96 @@ size_t dll_find_f(dll_list_t *list, void *data, find_function_t find_fn);
 
 /**
  * @brief Sorts the list based on a custom comparison function.
+ * 
+ * The sort is a stable bottom-up merge sort that relinks the nodes in place,
+ * without moving the data or allocating memory.
+ * 
  * @param list The list to sort.
- * @param compare_fn The comparison function to use for sorting.
+ * @param compare_fn The comparison function, called with pointers to the data of two nodes.
  * @param order The desired sort order.
  */
 void dll_sort(dll_list_t *list, compare_function_t compare_fn, sort_order_t order);
 
+/**
+ * @brief Sorts the list on several threads.
+ * 
+ * The list is cut into one contiguous sublist per thread (the pool's workers
+ * and the caller), the sublists are sorted concurrently with the same merge
+ * sort as dll_sort, and neighbouring sublists are then merged in pairs, each
+ * level of the merge tree in parallel. The last merge runs as two halves at
+ * once, one from the front and one from the back, so it still takes n / 2
+ * steps on the critical path; every other pass over the nodes is split
+ * between the sublists. Nodes are only relinked, never copied, and the
+ * result is the same stable order dll_sort produces. Lists too short to give
+ * every thread DLL_SORT_PARALLEL_MIN_NODES nodes use fewer threads, down to
+ * plain dll_sort.
+ * 
+ * The pool belongs to the caller, so repeated sorts share its threads.
+ * compare_fn is called from several threads at once and must be thread-safe.
+ * 
+ * @param list The list to sort.
+ * @param compare_fn The comparison function, called with pointers to the data of two nodes.
+ * @param order The desired sort order.
+ * @param pool The pool to sort on, NULL to sort on the calling thread alone.
+ *        At most DLL_SORT_PARALLEL_MAX_THREADS threads are used.
+ */
+void dll_sort_parallel(dll_list_t *list, compare_function_t compare_fn, sort_order_t order, thread_pool_t *pool);
+
+/**
+ * @brief Moves count nodes of src, starting at index first, into dest in front of index.
+ * 
+ * When both lists share a node pool, or neither is pooled and both use the
+ * same allocator, the nodes are relinked as they are, so the cost is that of
+ * finding the three positions, from whichever end or cached cursor is
+ * closest. Otherwise each payload is copied into a new node of dest. The
+ * lists must be distinct and hold data of the same size.
+ * 
+ * @param dest The list receiving the nodes.
+ * @param index The position in dest the nodes are inserted at, dest's size to append.
+ * @param src The list the nodes are taken from.
+ * @param first The position in src of the first node to move.
+ * @param count The number of nodes to move.
+ */
+void dll_splice(dll_list_t *dest, size_t index, dll_list_t *src, size_t first, size_t count);
+
+/**
+ * @brief Moves every node of src to the end of dest, leaving src empty.
+ * 
+ * Takes constant time when the nodes can be relinked (see dll_splice).
+ * 
+ * @param dest The list receiving the nodes.
+ * @param src The list the nodes are taken from.
+ */
+void dll_concat(dll_list_t *dest, dll_list_t *src);
+
+/**
+ * @brief Splits the list in two at index.
+ * 
+ * The list keeps its first index nodes, and the rest move to a new list
+ * created with dll_create_shared. The nodes are relinked, so only the split
+ * point has to be found, and a pooled list shares its pool with the new list
+ * rather than allocating a second one.
+ * 
+ * @param list The list to split.
+ * @param index The position of the first node of the new list.
+ * @return dll_list_t* The new list, NULL if index is past the end.
+ */
+dll_list_t *dll_split_at(dll_list_t *list, size_t index);
+
+/**
+ * @brief Merges the nodes of src into dest, leaving src empty.
+ * 
+ * Both lists must already be sorted with compare_fn and order. The merge is
+ * stable, with the nodes of dest before equal nodes of src, and relinks the
+ * nodes when it can (see dll_splice).
+ * 
+ * @param dest The list receiving the nodes.
+ * @param src The list the nodes are taken from.
+ * @param compare_fn The comparison function both lists are sorted with.
+ * @param order The order both lists are sorted in.
+ */
+void dll_merge(dll_list_t *dest, dll_list_t *src, compare_function_t compare_fn, sort_order_t order);
+
 /**
  * @brief Reverses the order of nodes in the list.
  * @param list The list to reverse.
@@ -216,4 +446,240 @@ bool dll_empty(dll_list_t *list);
  */
 void dll_print(dll_list_t *list);
 
+/*
+ * Helpers of the DEFINE_LIST functions. dll_node_take returns a node of
+ * node_size bytes without its links set, or NULL when a pooled list needs a
+ * new slab; dll_node_near returns the node at index when it is the head, the
+ * tail, the cursor or the node right after it, and NULL otherwise.
+ */
+static inline dll_node_t *dll_node_take(dll_list_t *list, size_t node_size)
+{
+    dll_node_pool_t *pool = list->pool;
+    dll_node_t *node;
+
+    if (pool == NULL) {
+        return ALLOCATOR_ALLOC(&list->allocator, node_size);
+    }
+
+    if (pool->free_list != NULL) {
+        node = pool->free_list;
+        pool->free_list = node->next;
+        return node;
+    }
+
+    if (pool->current != NULL && pool->current->used < pool->current->capacity) {
+        node = (dll_node_t *)(pool->current->cells + pool->current->used * pool->cell_size);
+        pool->current->used++;
+        return node;
+    }
+
+    return NULL;
+}
+
+static inline dll_node_t *dll_node_near(dll_list_t *list, size_t index)
+{
+    if (index >= list->size) {
+        return NULL;
+    }
+
+    if (list->cursor_node != NULL) {
+        if (index == list->cursor_index) {
+            return list->cursor_node;
+        }
+        if (index == list->cursor_index + 1) {
+            return list->cursor_node->next;
+        }
+    }
+
+    if (index == 0) {
+        return list->head;
+    }
+    if (index == list->size - 1) {
+        return list->tail;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Defines typed, inline list operations for elements of type T, prefixed with name.
+ *
+ * The generated functions work on ordinary dll_list_t instances holding
+ * sizeof(T)-byte elements, so typed and void * calls can be mixed on the same
+ * list. With the element size known at compile time, an insertion takes its
+ * node straight from the pool's free list or current slab (or from the
+ * allocator for an unpooled list), stores the value with a plain assignment
+ * and links the node in place; only a pooled list that needs a new slab goes
+ * through list.c. Reads at the ends, at the cursor or right after it are
+ * plain loads, which makes a loop over get with increasing indices linear;
+ * other positions are found by dll_get. Iterating over the nodes with
+ * name_value is the cheapest way to visit every element. For
+ * DEFINE_LIST(int_list, int):
+ *
+ *   dll_list_t *int_list_create(void);
+ *   dll_list_t *int_list_from_array(const int *array, size_t count);
+ *   void int_list_append(dll_list_t *list, int value);
+ *   void int_list_prepend(dll_list_t *list, int value);
+ *   void int_list_insert(dll_list_t *list, size_t index, int value);
+ *   bool int_list_front(dll_list_t *list, int *value);
+ *   bool int_list_back(dll_list_t *list, int *value);
+ *   bool int_list_get(dll_list_t *list, size_t index, int *value);
+ *   int *int_list_value(dll_node_t *node);
+ *
+ * front, back and get return false when there is no such element.
+ */
+#define DEFINE_LIST(name, T)                                                                        \
+static inline dll_list_t *name##_create(void)                                                       \
+{                                                                                                   \
+    return dll_create(sizeof(T), NULL, NULL);                                                       \
+}                                                                                                   \
+                                                                                                    \
+static inline dll_list_t *name##_from_array(const T *array, size_t count)                           \
+{                                                                                                   \
+    return dll_from_array(sizeof(T), array, count, NULL, NULL);                                     \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_append(dll_list_t *list, T value)                                         \
+{                                                                                                   \
+    assert(list->data_size == sizeof(T));                                                           \
+                                                                                                    \
+    dll_node_t *node = dll_node_take(list, sizeof(dll_node_t) + sizeof(T));                         \
+                                                                                                    \
+    if (node == NULL) {                                                                             \
+        dll_append(list, &value);                                                                   \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    *(T *)node->data = value;                                                                       \
+    node->next = NULL;                                                                              \
+    node->prev = list->tail;                                                                        \
+                                                                                                    \
+    if (list->tail != NULL) {                                                                       \
+        list->tail->next = node;                                                                    \
+    } else {                                                                                        \
+        list->head = node;                                                                          \
+    }                                                                                               \
+    list->tail = node;                                                                              \
+                                                                                                    \
+    list->size++;                                                                                   \
+    list->error = ERROR_NONE;                                                                       \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_prepend(dll_list_t *list, T value)                                        \
+{                                                                                                   \
+    assert(list->data_size == sizeof(T));                                                           \
+                                                                                                    \
+    dll_node_t *node = dll_node_take(list, sizeof(dll_node_t) + sizeof(T));                         \
+                                                                                                    \
+    if (node == NULL) {                                                                             \
+        dll_prepend(list, &value);                                                                  \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    *(T *)node->data = value;                                                                       \
+    node->prev = NULL;                                                                              \
+    node->next = list->head;                                                                        \
+                                                                                                    \
+    if (list->head != NULL) {                                                                       \
+        list->head->prev = node;                                                                    \
+    } else {                                                                                        \
+        list->tail = node;                                                                          \
+    }                                                                                               \
+    list->head = node;                                                                              \
+                                                                                                    \
+    list->size++;                                                                                   \
+    if (list->cursor_node != NULL) {                                                                \
+        list->cursor_index++;                                                                       \
+    }                                                                                               \
+    list->error = ERROR_NONE;                                                                       \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_insert(dll_list_t *list, size_t index, T value)                           \
+{                                                                                                   \
+    assert(list->data_size == sizeof(T));                                                           \
+                                                                                                    \
+    if (index == 0 && list->size > 0) {                                                             \
+        name##_prepend(list, value);                                                                \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    dll_node_t *next_node = dll_node_near(list, index);                                             \
+    dll_node_t *node = next_node != NULL ? dll_node_take(list, sizeof(dll_node_t) + sizeof(T)) : NULL;\
+                                                                                                    \
+    if (node == NULL) {                                                                             \
+        dll_insert(list, index, &value);                                                            \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    *(T *)node->data = value;                                                                       \
+    node->next = next_node;                                                                         \
+    node->prev = next_node->prev;                                                                   \
+                                                                                                    \
+    next_node->prev->next = node;                                                                   \
+    next_node->prev = node;                                                                         \
+                                                                                                    \
+    list->size++;                                                                                   \
+    list->cursor_node = node;                                                                       \
+    list->cursor_index = index;                                                                     \
+    list->error = ERROR_NONE;                                                                       \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_front(dll_list_t *list, T *value)                                         \
+{                                                                                                   \
+    assert(list->data_size == sizeof(T));                                                           \
+                                                                                                    \
+    if (list->head == NULL) {                                                                       \
+        list->error = ERROR_NULL;                                                                   \
+        return false;                                                                               \
+    }                                                                                               \
+                                                                                                    \
+    *value = *(T *)list->head->data;                                                                \
+    list->error = ERROR_NONE;                                                                       \
+    return true;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_back(dll_list_t *list, T *value)                                          \
+{                                                                                                   \
+    assert(list->data_size == sizeof(T));                                                           \
+                                                                                                    \
+    if (list->tail == NULL) {                                                                       \
+        list->error = ERROR_NULL;                                                                   \
+        return false;                                                                               \
+    }                                                                                               \
+                                                                                                    \
+    *value = *(T *)list->tail->data;                                                                \
+    list->error = ERROR_NONE;                                                                       \
+    return true;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_get(dll_list_t *list, size_t index, T *value)                             \
+{                                                                                                   \
+    assert(list->data_size == sizeof(T));                                                           \
+                                                                                                    \
+    dll_node_t *node = dll_node_near(list, index);                                                  \
+                                                                                                    \
+    if (node == NULL) {                                                                             \
+        T *data = dll_get(list, index);                                                             \
+                                                                                                    \
+        if (data == NULL) {                                                                         \
+            return false;                                                                           \
+        }                                                                                           \
+                                                                                                    \
+        *value = *data;                                                                             \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    list->cursor_node = node;                                                                       \
+    list->cursor_index = index;                                                                     \
+                                                                                                    \
+    *value = *(T *)node->data;                                                                      \
+    list->error = ERROR_NONE;                                                                       \
+    return true;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+static inline T *name##_value(dll_node_t *node)                                                     \
+{                                                                                                   \
+    return (T *)node->data;                                                                         \
+}
+
 #endif // LIST_H
@@ -0,0 +1,471 @@
+/**
+ * @file skip_list.c
+ * @author Secareanu Filip
+ * @brief Indexable skip list implementation.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "skip_list.h"
+
+static size_t isl_data_offset(size_t level)
+{
+	size_t align = _Alignof(max_align_t);
+
+	return (sizeof(isl_node_t) + level * sizeof(isl_link_t) + align - 1) / align * align;
+}
+
+static size_t isl_node_bytes(isl_list_t *list, isl_node_t *node)
+{
+	return isl_data_offset(node->level) + list->data_size;
+}
+
+static void *isl_node_data(isl_node_t *node)
+{
+	return (unsigned char *)node + isl_data_offset(node->level);
+}
+
+static size_t isl_random_level(isl_list_t *list)
+{
+	uint64_t bits;
+	size_t level;
+
+	// xorshift64, every level is kept with probability 1/2
+	list->seed ^= list->seed << 13;
+	list->seed ^= list->seed >> 7;
+	list->seed ^= list->seed << 17;
+
+	bits = list->seed;
+	level = 1;
+
+	while ((bits & 1) && level < ISL_MAX_LEVEL) {
+		bits >>= 1;
+		level++;
+	}
+
+	return level;
+}
+
+/*
+ * Fills update with the last node before position index + 1 on every level,
+ * where the sentinel sits at position 0 and element i at position i + 1.
+ */
+static void isl_find_path(isl_list_t *list, size_t index, isl_node_t **update, size_t *update_pos)
+{
+	isl_node_t *current_node;
+	size_t position;
+
+	current_node = list->head;
+	position = 0;
+
+	// The loop always reaches level 0, but the compiler cannot tell that list->level >= 1
+	update[0] = list->head;
+	update_pos[0] = 0;
+
+	for (size_t i = list->level; i-- > 0;) {
+		while (current_node->links[i].next != NULL && position + current_node->links[i].width <= index) {
+			position += current_node->links[i].width;
+			current_node = current_node->links[i].next;
+		}
+
+		update[i] = current_node;
+		update_pos[i] = position;
+	}
+}
+
+static isl_node_t *isl_node_at(isl_list_t *list, size_t index)
+{
+	isl_node_t *current_node;
+	size_t position;
+
+	current_node = list->head;
+	position = 0;
+
+	for (size_t i = list->level; i-- > 0;) {
+		while (current_node->links[i].next != NULL && position + current_node->links[i].width <= index + 1) {
+			position += current_node->links[i].width;
+			current_node = current_node->links[i].next;
+		}
+	}
+
+	return current_node;
+}
+
+static void isl_insert_at(isl_list_t *list, size_t index, const void *data)
+{
+	isl_node_t *update[ISL_MAX_LEVEL];
+	size_t update_pos[ISL_MAX_LEVEL];
+	isl_node_t *new_node;
+	size_t new_level;
+	size_t position;
+
+	isl_find_path(list, index, update, update_pos);
+
+	new_level = isl_random_level(list);
+
+	for (size_t i = list->level; i < new_level; i++) {
+		update[i] = list->head;
+		update_pos[i] = 0;
+
+		list->head->links[i].next = NULL;
+		list->head->links[i].width = 0;
+	}
+
+	if (new_level > list->level) {
+		list->level = new_level;
+	}
+
+	new_node = ALLOCATOR_ALLOC(&list->allocator, isl_data_offset(new_level) + list->data_size);
+	new_node->level = new_level;
+	memcpy(isl_node_data(new_node), data, list->data_size);
+
+	position = index + 1;
+
+	for (size_t i = 0; i < new_level; i++) {
+		isl_link_t *link = &update[i]->links[i];
+
+		new_node->links[i].next = link->next;
+		new_node->links[i].width = link->next != NULL ? update_pos[i] + link->width + 1 - position : 0;
+
+		link->next = new_node;
+		link->width = position - update_pos[i];
+	}
+
+	// Links above the new node now jump over one more element
+	for (size_t i = new_level; i < list->level; i++) {
+		if (update[i]->links[i].next != NULL) {
+			update[i]->links[i].width++;
+		}
+	}
+
+	list->size++;
+}
+
+isl_list_t *isl_create(size_t data_size, free_function_t free_fn, print_function_t print_fn)
+{
+	return isl_create_a(data_size, free_fn, print_fn, NULL);
+}
+
+isl_list_t *isl_create_a(size_t data_size, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator)
+{
+	isl_list_t *new_list;
+
+	if (allocator == NULL) {
+		allocator = default_allocator();
+	}
+
+	new_list = ALLOCATOR_CALLOC(allocator, 1, sizeof(isl_list_t));
+
+	new_list->allocator = *allocator;
+
+	new_list->head = ALLOCATOR_CALLOC(allocator, 1, sizeof(isl_node_t) + ISL_MAX_LEVEL * sizeof(isl_link_t));
+	new_list->head->level = ISL_MAX_LEVEL;
+	new_list->level = 1;
+
+	new_list->data_size = data_size;
+	new_list->size = 0;
+
+	new_list->seed = 0x9E3779B97F4A7C15ULL ^ (uintptr_t)new_list;
+
+	new_list->free_fn = free_fn;
+	new_list->print_fn = print_fn;
+
+	new_list->error = ERROR_NONE;
+
+	return new_list;
+}
+
+void isl_destroy(isl_list_t **list)
+{
+	if ((*list) == NULL) {
+		return;
+	}
+
+	allocator_t allocator;
+
+	allocator = (*list)->allocator;
+
+	isl_clear(*list);
+	allocator_free(&allocator, (*list)->head, sizeof(isl_node_t) + ISL_MAX_LEVEL * sizeof(isl_link_t));
+	allocator_free(&allocator, *list, sizeof(isl_list_t));
+
+	*list = NULL;
+}
+
+void *isl_front(isl_list_t *list)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	if (list->size == 0) {
+		list->error = ERROR_NULL;
+		return NULL;
+	}
+
+	list->error = ERROR_NONE;
+
+	return isl_node_data(list->head->links[0].next);
+}
+
+void *isl_back(isl_list_t *list)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	if (list->size == 0) {
+		list->error = ERROR_NULL;
+		return NULL;
+	}
+
+	list->error = ERROR_NONE;
+
+	return isl_node_data(isl_node_at(list, list->size - 1));
+}
+
+void isl_append(isl_list_t *list, void *data)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	isl_insert_at(list, list->size, data);
+
+	list->error = ERROR_NONE;
+}
+
+void isl_prepend(isl_list_t *list, void *data)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	isl_insert_at(list, 0, data);
+
+	list->error = ERROR_NONE;
+}
+
+void isl_insert(isl_list_t *list, size_t index, void *data)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	if (index >= list->size) {
+		list->error = ERROR_INVALID_INDEX;
+		return;
+	}
+
+	isl_insert_at(list, index, data);
+
+	list->error = ERROR_NONE;
+}
+
+void isl_remove(isl_list_t *list, size_t index)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (index >= list->size) {
+		list->error = ERROR_INVALID_INDEX;
+		return;
+	}
+
+	isl_node_t *update[ISL_MAX_LEVEL];
+	size_t update_pos[ISL_MAX_LEVEL];
+	isl_node_t *to_delete;
+
+	isl_find_path(list, index, update, update_pos);
+
+	to_delete = update[0]->links[0].next;
+
+	for (size_t i = 0; i < list->level; i++) {
+		isl_link_t *link = &update[i]->links[i];
+
+		if (link->next == to_delete) {
+			link->width += to_delete->links[i].width - 1;
+			link->next = to_delete->links[i].next;
+		} else if (link->next != NULL) {
+			link->width--;
+		}
+	}
+
+	while (list->level > 1 && list->head->links[list->level - 1].next == NULL) {
+		list->level--;
+	}
+
+	if (list->free_fn != NULL) {
+		list->free_fn(isl_node_data(to_delete));
+	}
+	allocator_free(&list->allocator, to_delete, isl_node_bytes(list, to_delete));
+
+	list->size--;
+
+	list->error = ERROR_NONE;
+}
+
+void isl_clear(isl_list_t *list)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (list->free_fn != NULL || list->allocator.free != NULL) {
+		isl_node_t *current_node;
+		isl_node_t *next_node;
+
+		current_node = list->head->links[0].next;
+
+		while (current_node != NULL) {
+			next_node = current_node->links[0].next;
+
+			if (list->free_fn != NULL) {
+				list->free_fn(isl_node_data(current_node));
+			}
+			allocator_free(&list->allocator, current_node, isl_node_bytes(list, current_node));
+
+			current_node = next_node;
+		}
+	}
+
+	for (size_t i = 0; i < ISL_MAX_LEVEL; i++) {
+		list->head->links[i].next = NULL;
+		list->head->links[i].width = 0;
+	}
+
+	list->level = 1;
+	list->size = 0;
+
+	list->error = ERROR_NONE;
+}
+
+void *isl_get(isl_list_t *list, size_t index)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	if (index >= list->size) {
+		list->error = ERROR_INVALID_INDEX;
+		return NULL;
+	}
+
+	list->error = ERROR_NONE;
+
+	return isl_node_data(isl_node_at(list, index));
+}
+
+size_t isl_find(isl_list_t *list, void *data)
+{
+	if (list == NULL) {
+		return SIZE_MAX;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return SIZE_MAX;
+	}
+
+	isl_node_t *current_node = list->head->links[0].next;
+	for (size_t i = 0; i < list->size; i++) {
+		if (memcmp(isl_node_data(current_node), data, list->data_size) == 0) {
+			list->error = ERROR_NONE;
+			return i;
+		}
+		current_node = current_node->links[0].next;
+	}
+
+	list->error = ERROR_NONE;
+
+	return SIZE_MAX;
+}
+
+size_t isl_find_f(isl_list_t *list, void *data, find_function_t find_fn)
+{
+	if (list == NULL) {
+		return SIZE_MAX;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return SIZE_MAX;
+	}
+
+	if (find_fn == NULL) {
+		list->error = ERROR_INVALID_FUNCTION;
+		return SIZE_MAX;
+	}
+
+	isl_node_t *current_node = list->head->links[0].next;
+	for (size_t i = 0; i < list->size; i++) {
+		if (find_fn(isl_node_data(current_node), data)) {
+			list->error = ERROR_NONE;
+			return i;
+		}
+		current_node = current_node->links[0].next;
+	}
+
+	list->error = ERROR_NONE;
+
+	return SIZE_MAX;
+}
+
+size_t isl_size(isl_list_t *list)
+{
+	if (list == NULL) {
+		return 0;
+	}
+
+	list->error = ERROR_NONE;
+
+	return list->size;
+}
+
+bool isl_empty(isl_list_t *list)
+{
+	if (list == NULL) {
+		return false;
+	}
+
+	list->error = ERROR_NONE;
+
+	return list->size == 0;
+}
+
+void isl_print(isl_list_t *list)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (list->print_fn == NULL) {
+		list->error = ERROR_INVALID_FUNCTION;
+		return;
+	}
+
+	for (isl_node_t *current_node = list->head->links[0].next; current_node != NULL; current_node = current_node->links[0].next) {
+		list->print_fn(isl_node_data(current_node));
+	}
+
+	list->error = ERROR_NONE;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file skip_list.h
+ * @author Secareanu Filip
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This module provides methods to manipulate and query indexable skip lists.
+ * An indexable skip list keeps the elements in insertion order, like the
+ * doubly linked list, but every node also owns a random number of express
+ * links, and every link records how many elements it jumps over (its width).
+ * Summing the widths while descending the levels reaches any index in
+ * O(log n) expected time, so access, insertion and removal by index no longer
+ * need to walk the list. Custom free and print functions are supported just
+ * like in the doubly linked list.
+ *
+ */
+
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include "../common/error/error.h"
+#include "../common/generic/container_utils.h"
+#include "../common/generic/memory_utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The maximum number of levels of a node.
+ *
+ */
+#define ISL_MAX_LEVEL 32
+
+/**
+ * @brief Node structure for the indexable skip list.
+ *
+ * The links are followed, in the same allocation, by the data of the node.
+ */
+typedef struct isl_node isl_node_t;
+/**
+ * @brief Forward link of a node at a given level.
+ *
+ */
+typedef struct isl_link isl_link_t;
+/**
+ * @brief Main structure representing the indexable skip list.
+ *
+ */
+typedef struct isl_list isl_list_t;
+
+struct isl_link {
+    isl_node_t *next;           /**< The next node at this level*/
+    size_t width;               /**< The number of elements the link jumps over*/
+};
+
+struct isl_node {
+    size_t level;               /**< The number of links of the node*/
+    isl_link_t links[];         /**< The forward links, level 0 links every element*/
+};
+
+struct isl_list {
+    isl_node_t *head;           /**< The sentinel node, with ISL_MAX_LEVEL links and no data*/
+    size_t level;               /**< The number of levels currently in use*/
+
+    size_t data_size;           /**< The size of the data held by the list*/
+    size_t size;                /**< The size of the list*/
+
+    uint64_t seed;              /**< The state of the generator for node levels*/
+
+    container_error_t error;    /**< The error code of the last operation*/
+
+    free_function_t free_fn;    /**< The custom free function*/
+    print_function_t print_fn;  /**< The custom print function*/
+
+    allocator_t allocator;      /**< The allocator used for the list and its nodes*/
+};
+
+/**
+ * @brief Creates a new indexable skip list.
+ *
+ * @param data_size The size of the data held by the list.
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @return isl_list_t* The newly created list.
+ */
+isl_list_t *isl_create(size_t data_size, free_function_t free_fn, print_function_t print_fn);
+
+/**
+ * @brief Creates a new indexable skip list that allocates through a custom allocator.
+ *
+ * @param data_size The size of the data held by the list.
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @param allocator The allocator (copied into the list), NULL for the default allocator.
+ * @return isl_list_t* The newly created list.
+ */
+isl_list_t *isl_create_a(size_t data_size, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator);
+
+/**
+ * @brief Destroys the list and frees all the memory.
+ *
+ * @param list The list to be destroyed.
+ */
+void isl_destroy(isl_list_t **list);
+
+/**
+ * @brief Retrieves the data from the beginning of the list.
+ *
+ * @param list The list to retrieve data from.
+ * @return void* Data of the first element.
+ */
+void* isl_front(isl_list_t *list);
+
+/**
+ * @brief Retrieves the data from the end of the list.
+ *
+ * @param list The list to retrieve data from.
+ * @return void* Data of the last element.
+ */
+void* isl_back(isl_list_t *list);
+
+
+/**
+ * @brief Appends data to the end of the list.
+ *
+ * @param list The list to append data to.
+ * @param data The data to be appended.
+ */
+void isl_append(isl_list_t *list, void *data);
+
+/**
+ * @brief Prepends data to the beginning of the list.
+ *
+ * @param list The list to prepend data to.
+ * @param data The data to be prepended.
+ */
+void isl_prepend(isl_list_t *list, void *data);
+
+/**
+ * @brief Inserts data at the specified index in O(log n) expected time.
+ *
+ * @param list The list to insert data to.
+ * @param index The index at which to insert the data.
+ * @param data The data to be inserted.
+ */
+void isl_insert(isl_list_t *list, size_t index, void *data);
+
+
+/**
+ * @brief Removes the element at a specific index in O(log n) expected time.
+ * @param list The list to remove the element from.
+ * @param index The index of the element to remove.
+ */
+void isl_remove(isl_list_t *list, size_t index);
+
+/**
+ * @brief Removes all the elements from the list.
+ * @param list The list to clear.
+ */
+void isl_clear(isl_list_t *list);
+
+
+/**
+ * @brief Retrieves data at a specific index in O(log n) expected time.
+ * @param list The list to retrieve data from.
+ * @param index The index to retrieve data from.
+ * @return Data at the specified index.
+ */
+void* isl_get(isl_list_t *list, size_t index);
+
+/**
+ * @brief Finds the index of a specific data item in the list.
+ * @param list The list to search.
+ * @param data The data to find.
+ * @return Index of the data item or SIZE_MAX if not found.
+ */
+size_t isl_find(isl_list_t *list, void *data);
+
+/**
+ * @brief Finds the index of a specific data item using a custom function.
+ * @param list The list to search.
+ * @param data The data to find.
+ * @param find_fn Custom function to use for searching.
+ * @return Index of the data item or SIZE_MAX if not found.
+ */
+size_t isl_find_f(isl_list_t *list, void *data, find_function_t find_fn);
+
+
+/**
+ * @brief Retrieves the size (number of elements) of the list.
+ * @param list The list to retrieve the size for.
+ * @return The size of the list.
+ */
+size_t isl_size(isl_list_t *list);
+
+/**
+ * @brief Determines if the list is empty.
+ * @param list The list to check.
+ * @return true if the list is empty, false otherwise.
+ */
+bool isl_empty(isl_list_t *list);
+
+
+/**
+ * @brief Prints the list using the assigned print function.
+ * @param list The list to print.
+ */
+void isl_print(isl_list_t *list);
+
+#endif // SKIP_LIST_H
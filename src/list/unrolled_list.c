@@ -0,0 +1,516 @@
+/**
+ * @file unrolled_list.c
+ * @author Secareanu Filip
+ * @brief Unrolled linked list implementation.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "unrolled_list.h"
+
+static size_t ull_node_bytes(ull_list_t *list)
+{
+	return sizeof(ull_node_t) + list->node_capacity * list->data_size;
+}
+
+static void *ull_slot(ull_list_t *list, ull_node_t *node, size_t offset)
+{
+	return node->data + offset * list->data_size;
+}
+
+static ull_node_t *ull_node_create(ull_list_t *list)
+{
+	ull_node_t *new_node;
+
+	new_node = ALLOCATOR_ALLOC(&list->allocator, ull_node_bytes(list));
+
+	new_node->next = NULL;
+	new_node->prev = NULL;
+	new_node->count = 0;
+
+	return new_node;
+}
+
+static void ull_node_link_after(ull_list_t *list, ull_node_t *node, ull_node_t *new_node)
+{
+	if (node == NULL) {
+		new_node->next = list->head;
+		new_node->prev = NULL;
+
+		if (list->head != NULL) {
+			list->head->prev = new_node;
+		} else {
+			list->tail = new_node;
+		}
+		list->head = new_node;
+	} else {
+		new_node->next = node->next;
+		new_node->prev = node;
+
+		if (node->next != NULL) {
+			node->next->prev = new_node;
+		} else {
+			list->tail = new_node;
+		}
+		node->next = new_node;
+	}
+}
+
+static void ull_node_destroy(ull_list_t *list, ull_node_t *node)
+{
+	if (node->prev != NULL) {
+		node->prev->next = node->next;
+	} else {
+		list->head = node->next;
+	}
+
+	if (node->next != NULL) {
+		node->next->prev = node->prev;
+	} else {
+		list->tail = node->prev;
+	}
+
+	if (list->cursor_node == node) {
+		list->cursor_node = NULL;
+	}
+
+	allocator_free(&list->allocator, node, ull_node_bytes(list));
+}
+
+static size_t ull_distance(size_t a, size_t b)
+{
+	return a > b ? a - b : b - a;
+}
+
+static ull_node_t *ull_locate(ull_list_t *list, size_t index, size_t *offset)
+{
+	ull_node_t *current_node;
+	size_t base;
+
+	// Walk from whichever of head, tail or the cached cursor is closest
+	current_node = list->head;
+	base = 0;
+
+	if (list->size - 1 - index < index) {
+		current_node = list->tail;
+		base = list->size - list->tail->count;
+	}
+
+	if (list->cursor_node != NULL && ull_distance(list->cursor_base, index) < ull_distance(base, index)) {
+		current_node = list->cursor_node;
+		base = list->cursor_base;
+	}
+
+	while (index >= base + current_node->count) {
+		base += current_node->count;
+		current_node = current_node->next;
+	}
+
+	while (index < base) {
+		current_node = current_node->prev;
+		base -= current_node->count;
+	}
+
+	list->cursor_node = current_node;
+	list->cursor_base = base;
+
+	*offset = index - base;
+
+	return current_node;
+}
+
+static void ull_node_insert(ull_list_t *list, ull_node_t *node, size_t offset, const void *data)
+{
+	memmove(ull_slot(list, node, offset + 1), ull_slot(list, node, offset), (node->count - offset) * list->data_size);
+	memcpy(ull_slot(list, node, offset), data, list->data_size);
+
+	node->count++;
+}
+
+ull_list_t *ull_create(size_t data_size, size_t node_capacity, free_function_t free_fn, print_function_t print_fn)
+{
+	return ull_create_a(data_size, node_capacity, free_fn, print_fn, NULL);
+}
+
+ull_list_t *ull_create_a(size_t data_size, size_t node_capacity, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator)
+{
+	ull_list_t *new_list;
+
+	if (allocator == NULL) {
+		allocator = default_allocator();
+	}
+
+	new_list = ALLOCATOR_CALLOC(allocator, 1, sizeof(ull_list_t));
+
+	new_list->allocator = *allocator;
+
+	new_list->head = NULL;
+	new_list->tail = NULL;
+
+	new_list->data_size = data_size;
+	new_list->node_capacity = node_capacity > 0 ? node_capacity : 1;
+	new_list->size = 0;
+
+	new_list->cursor_node = NULL;
+	new_list->cursor_base = 0;
+
+	new_list->free_fn = free_fn;
+	new_list->print_fn = print_fn;
+
+	new_list->error = ERROR_NONE;
+
+	return new_list;
+}
+
+void ull_destroy(ull_list_t **list)
+{
+	if ((*list) == NULL) {
+		return;
+	}
+
+	allocator_t allocator;
+
+	allocator = (*list)->allocator;
+
+	ull_clear(*list);
+	allocator_free(&allocator, *list, sizeof(ull_list_t));
+
+	*list = NULL;
+}
+
+void *ull_front(ull_list_t *list)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	if (list->head == NULL) {
+		list->error = ERROR_NULL;
+		return NULL;
+	}
+
+	list->error = ERROR_NONE;
+
+	return ull_slot(list, list->head, 0);
+}
+
+void *ull_back(ull_list_t *list)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	if (list->tail == NULL) {
+		list->error = ERROR_NULL;
+		return NULL;
+	}
+
+	list->error = ERROR_NONE;
+
+	return ull_slot(list, list->tail, list->tail->count - 1);
+}
+
+void ull_append(ull_list_t *list, void *data)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	if (list->tail == NULL || list->tail->count == list->node_capacity) {
+		ull_node_link_after(list, list->tail, ull_node_create(list));
+	}
+
+	memcpy(ull_slot(list, list->tail, list->tail->count), data, list->data_size);
+	list->tail->count++;
+
+	list->size++;
+
+	list->error = ERROR_NONE;
+}
+
+void ull_prepend(ull_list_t *list, void *data)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	if (list->head == NULL || list->head->count == list->node_capacity) {
+		ull_node_link_after(list, NULL, ull_node_create(list));
+	}
+
+	ull_node_insert(list, list->head, 0, data);
+
+	list->size++;
+
+	// Every node but the head moved one position further
+	if (list->cursor_node != NULL && list->cursor_node != list->head) {
+		list->cursor_base++;
+	}
+
+	list->error = ERROR_NONE;
+}
+
+void ull_insert(ull_list_t *list, size_t index, void *data)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return;
+	}
+
+	if (index >= list->size) {
+		list->error = ERROR_INVALID_INDEX;
+		return;
+	}
+
+	ull_node_t *current_node;
+	size_t offset;
+
+	current_node = ull_locate(list, index, &offset);
+
+	if (current_node->count == list->node_capacity) {
+		ull_node_t *new_node;
+		size_t half;
+
+		// Split the node, moving its upper half into a new successor
+		new_node = ull_node_create(list);
+		half = current_node->count / 2;
+
+		memcpy(new_node->data, ull_slot(list, current_node, half), (current_node->count - half) * list->data_size);
+		new_node->count = current_node->count - half;
+		current_node->count = half;
+
+		ull_node_link_after(list, current_node, new_node);
+
+		if (offset > half) {
+			current_node = new_node;
+			offset -= half;
+		}
+	}
+
+	ull_node_insert(list, current_node, offset, data);
+
+	list->size++;
+
+	list->error = ERROR_NONE;
+}
+
+void ull_remove(ull_list_t *list, size_t index)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (index >= list->size) {
+		list->error = ERROR_INVALID_INDEX;
+		return;
+	}
+
+	ull_node_t *current_node;
+	size_t offset;
+
+	current_node = ull_locate(list, index, &offset);
+
+	if (list->free_fn != NULL) {
+		list->free_fn(ull_slot(list, current_node, offset));
+	}
+
+	memmove(ull_slot(list, current_node, offset), ull_slot(list, current_node, offset + 1), (current_node->count - offset - 1) * list->data_size);
+	current_node->count--;
+
+	list->size--;
+
+	if (current_node->count == 0) {
+		ull_node_destroy(list, current_node);
+	} else if (current_node->next != NULL && current_node->count < list->node_capacity / 2
+			&& current_node->count + current_node->next->count <= list->node_capacity) {
+		ull_node_t *next_node;
+
+		// Merge the successor to keep the nodes at least half full
+		next_node = current_node->next;
+
+		memcpy(ull_slot(list, current_node, current_node->count), next_node->data, next_node->count * list->data_size);
+		current_node->count += next_node->count;
+
+		ull_node_destroy(list, next_node);
+	}
+
+	list->error = ERROR_NONE;
+}
+
+void ull_clear(ull_list_t *list)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (list->free_fn != NULL || list->allocator.free != NULL) {
+		ull_node_t *current_node;
+		ull_node_t *next_node;
+
+		current_node = list->head;
+
+		while (current_node != NULL) {
+			next_node = current_node->next;
+
+			if (list->free_fn != NULL) {
+				for (size_t i = 0; i < current_node->count; i++) {
+					list->free_fn(ull_slot(list, current_node, i));
+				}
+			}
+			allocator_free(&list->allocator, current_node, ull_node_bytes(list));
+
+			current_node = next_node;
+		}
+	}
+
+	list->head = NULL;
+	list->tail = NULL;
+
+	list->size = 0;
+
+	list->cursor_node = NULL;
+	list->cursor_base = 0;
+
+	list->error = ERROR_NONE;
+}
+
+void *ull_get(ull_list_t *list, size_t index)
+{
+	if (list == NULL) {
+		return NULL;
+	}
+
+	if (index >= list->size) {
+		list->error = ERROR_INVALID_INDEX;
+		return NULL;
+	}
+
+	ull_node_t *current_node;
+	size_t offset;
+
+	current_node = ull_locate(list, index, &offset);
+
+	list->error = ERROR_NONE;
+
+	return ull_slot(list, current_node, offset);
+}
+
+size_t ull_find(ull_list_t *list, void *data)
+{
+	if (list == NULL) {
+		return SIZE_MAX;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return SIZE_MAX;
+	}
+
+	size_t base = 0;
+
+	for (ull_node_t *current_node = list->head; current_node != NULL; current_node = current_node->next) {
+		for (size_t i = 0; i < current_node->count; i++) {
+			if (memcmp(ull_slot(list, current_node, i), data, list->data_size) == 0) {
+				list->error = ERROR_NONE;
+				return base + i;
+			}
+		}
+		base += current_node->count;
+	}
+
+	list->error = ERROR_NONE;
+
+	return SIZE_MAX;
+}
+
+size_t ull_find_f(ull_list_t *list, void *data, find_function_t find_fn)
+{
+	if (list == NULL) {
+		return SIZE_MAX;
+	}
+
+	if (data == NULL) {
+		list->error = ERROR_INVALID_DATA;
+		return SIZE_MAX;
+	}
+
+	if (find_fn == NULL) {
+		list->error = ERROR_INVALID_FUNCTION;
+		return SIZE_MAX;
+	}
+
+	size_t base = 0;
+
+	for (ull_node_t *current_node = list->head; current_node != NULL; current_node = current_node->next) {
+		for (size_t i = 0; i < current_node->count; i++) {
+			if (find_fn(ull_slot(list, current_node, i), data)) {
+				list->error = ERROR_NONE;
+				return base + i;
+			}
+		}
+		base += current_node->count;
+	}
+
+	list->error = ERROR_NONE;
+
+	return SIZE_MAX;
+}
+
+size_t ull_size(ull_list_t *list)
+{
+	if (list == NULL) {
+		return 0;
+	}
+
+	list->error = ERROR_NONE;
+
+	return list->size;
+}
+
+bool ull_empty(ull_list_t *list)
+{
+	if (list == NULL) {
+		return false;
+	}
+
+	list->error = ERROR_NONE;
+
+	return list->size == 0;
+}
+
+void ull_print(ull_list_t *list)
+{
+	if (list == NULL) {
+		return;
+	}
+
+	if (list->print_fn == NULL) {
+		list->error = ERROR_INVALID_FUNCTION;
+		return;
+	}
+
+	for (ull_node_t *current_node = list->head; current_node != NULL; current_node = current_node->next) {
+		for (size_t i = 0; i < current_node->count; i++) {
+			list->print_fn(ull_slot(list, current_node, i));
+		}
+	}
+
+	list->error = ERROR_NONE;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file unrolled_list.h
+ * @author Secareanu Filip
+ * @brief
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This module provides methods to manipulate and query unrolled linked lists.
+ * Every node of an unrolled list stores up to node_capacity elements in a
+ * contiguous array, so walking the list touches one node per block of
+ * elements instead of one node per element, and the per-element overhead of
+ * the links is divided by the block size. The API mirrors the doubly linked
+ * list, including the custom free and print functions.
+ *
+ */
+
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include "../common/error/error.h"
+#include "../common/generic/container_utils.h"
+#include "../common/generic/memory_utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Node structure for the unrolled linked list.
+ *
+ */
+typedef struct ull_node ull_node_t;
+/**
+ * @brief Main structure representing the unrolled linked list.
+ *
+ */
+typedef struct ull_list ull_list_t;
+
+struct ull_node {
+    ull_node_t *next;           /**< The next node in the list*/
+    ull_node_t *prev;           /**< The previous node in the list*/
+    size_t count;               /**< The number of elements stored in the node*/
+    _Alignas(max_align_t) unsigned char data[];  /**< The elements (node_capacity * data_size bytes)*/
+};
+
+struct ull_list {
+    ull_node_t *head;           /**< The head of the list*/
+    ull_node_t *tail;           /**< The tail of the list*/
+
+    size_t data_size;           /**< The size of the data held by the list*/
+    size_t node_capacity;       /**< The maximum number of elements in a node*/
+    size_t size;                /**< The size of the list*/
+
+    ull_node_t *cursor_node;    /**< The last node accessed by index, NULL if unknown*/
+    size_t cursor_base;         /**< The index of the first element of the cursor node*/
+
+    container_error_t error;    /**< The error code of the last operation*/
+
+    free_function_t free_fn;    /**< The custom free function*/
+    print_function_t print_fn;  /**< The custom print function*/
+
+    allocator_t allocator;      /**< The allocator used for the list and its nodes*/
+};
+
+/**
+ * @brief Creates a new unrolled linked list.
+ *
+ * @param data_size The size of the data held by the list.
+ * @param node_capacity The number of elements stored per node (at least 1).
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @return ull_list_t* The newly created list.
+ */
+ull_list_t *ull_create(size_t data_size, size_t node_capacity, free_function_t free_fn, print_function_t print_fn);
+
+/**
+ * @brief Creates a new unrolled linked list that allocates through a custom allocator.
+ *
+ * @param data_size The size of the data held by the list.
+ * @param node_capacity The number of elements stored per node (at least 1).
+ * @param free_fn The custom free function.
+ * @param print_fn The custom print function.
+ * @param allocator The allocator (copied into the list), NULL for the default allocator.
+ * @return ull_list_t* The newly created list.
+ */
+ull_list_t *ull_create_a(size_t data_size, size_t node_capacity, free_function_t free_fn, print_function_t print_fn, const allocator_t *allocator);
+
+/**
+ * @brief Destroys the list and frees all the memory.
+ *
+ * @param list The list to be destroyed.
+ */
+void ull_destroy(ull_list_t **list);
+
+/**
+ * @brief Retrieves the data from the beginning of the list.
+ *
+ * @param list The list to retrieve data from.
+ * @return void* Data of the first element.
+ */
+void* ull_front(ull_list_t *list);
+
+/**
+ * @brief Retrieves the data from the end of the list.
+ *
+ * @param list The list to retrieve data from.
+ * @return void* Data of the last element.
+ */
+void* ull_back(ull_list_t *list);
+
+
+/**
+ * @brief Appends data to the end of the list.
+ *
+ * @param list The list to append data to.
+ * @param data The data to be appended.
+ */
+void ull_append(ull_list_t *list, void *data);
+
+/**
+ * @brief Prepends data to the beginning of the list.
+ *
+ * @param list The list to prepend data to.
+ * @param data The data to be prepended.
+ */
+void ull_prepend(ull_list_t *list, void *data);
+
+/**
+ * @brief Inserts data at the specified index.
+ *
+ * A full node is split in two halves to make room.
+ *
+ * @param list The list to insert data to.
+ * @param index The index at which to insert the data.
+ * @param data The data to be inserted.
+ */
+void ull_insert(ull_list_t *list, size_t index, void *data);
+
+
+/**
+ * @brief Removes the element at a specific index from the list.
+ *
+ * A node that drops to half its capacity is merged with its successor when
+ * both fit in one node.
+ *
+ * @param list The list to remove the element from.
+ * @param index The index of the element to remove.
+ */
+void ull_remove(ull_list_t *list, size_t index);
+
+/**
+ * @brief Removes all the elements from the list.
+ * @param list The list to clear.
+ */
+void ull_clear(ull_list_t *list);
+
+
+/**
+ * @brief Retrieves data at a specific index from the list.
+ *
+ * Sequential access is O(1) amortized thanks to the cached cursor node.
+ * Pointers returned are invalidated by any insertion or removal.
+ *
+ * @param list The list to retrieve data from.
+ * @param index The index to retrieve data from.
+ * @return Data at the specified index.
+ */
+void* ull_get(ull_list_t *list, size_t index);
+
+/**
+ * @brief Finds the index of a specific data item in the list.
+ * @param list The list to search.
+ * @param data The data to find.
+ * @return Index of the data item or SIZE_MAX if not found.
+ */
+size_t ull_find(ull_list_t *list, void *data);
+
+/**
+ * @brief Finds the index of a specific data item using a custom function.
+ * @param list The list to search.
+ * @param data The data to find.
+ * @param find_fn Custom function to use for searching.
+ * @return Index of the data item or SIZE_MAX if not found.
+ */
+size_t ull_find_f(ull_list_t *list, void *data, find_function_t find_fn);
+
+
+/**
+ * @brief Retrieves the size (number of elements) of the list.
+ * @param list The list to retrieve the size for.
+ * @return The size of the list.
+ */
+size_t ull_size(ull_list_t *list);
+
+/**
+ * @brief Determines if the list is empty.
+ * @param list The list to check.
+ * @return true if the list is empty, false otherwise.
+ */
+bool ull_empty(ull_list_t *list);
+
+
+/**
+ * @brief Prints the list using the assigned print function.
+ * @param list The list to print.
+ */
+void ull_print(ull_list_t *list);
+
+#endif // UNROLLED_LIST_H
@@ -0,0 +1,198 @@
+/**
+ * @file mpmc_queue.c
+ * @author Secareanu Filip
+ * @brief   This is the implementation for the bounded multi-producer/multi-consumer queue.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "mpmc_queue.h"
+
+typedef struct mpmc_cell mpmc_cell_t;
+
+/*
+ * The sequence of the cell at slot i starts at i. It reads pos when a
+ * producer at position pos may fill the cell, pos + 1 once the element is in
+ * place, and pos + capacity once a consumer emptied it for the next lap.
+ */
+struct mpmc_cell {
+    _Atomic size_t sequence;
+    _Alignas(max_align_t) unsigned char data[];
+};
+
+static mpmc_cell_t *mpmc_queue_cell(mpmc_queue_t *queue, size_t pos)
+{
+    return (mpmc_cell_t *)(queue->cells + (pos & (queue->capacity - 1)) * queue->cell_size);
+}
+
+mpmc_queue_t *mpmc_queue_create(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function)
+{
+    return mpmc_queue_create_a(data_size, capacity, free_function, print_function, NULL);
+}
+
+mpmc_queue_t *mpmc_queue_create_a(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    mpmc_queue_t *queue = ALLOCATOR_CALLOC(allocator, 1, sizeof(mpmc_queue_t));
+
+    queue->allocator = *allocator;
+
+    // A single cell could not tell "full" from "empty" apart
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    size_t align = _Alignof(mpmc_cell_t);
+
+    queue->cell_size = (sizeof(mpmc_cell_t) + data_size + align - 1) / align * align;
+    queue->data_size = data_size;
+    queue->capacity = rounded;
+
+    queue->cells = ALLOCATOR_ALLOC(allocator, rounded * queue->cell_size);
+
+    for (size_t i = 0; i < rounded; i++) {
+        atomic_init(&mpmc_queue_cell(queue, i)->sequence, i);
+    }
+
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+
+    queue->free_function = free_function;
+    queue->print_function = print_function;
+
+    return queue;
+}
+
+void mpmc_queue_destroy(mpmc_queue_t **queue, container_flags_t flag)
+{
+    if (*queue == NULL) {
+        return;
+    }
+
+    if (flag == CF_FREE_DATA && (*queue)->free_function != NULL) {
+        size_t head = atomic_load_explicit(&(*queue)->dequeue_pos, memory_order_acquire);
+        size_t tail = atomic_load_explicit(&(*queue)->enqueue_pos, memory_order_acquire);
+
+        for (size_t pos = head; pos != tail; pos++) {
+            (*queue)->free_function(mpmc_queue_cell(*queue, pos)->data);
+        }
+    }
+
+    allocator_t allocator = (*queue)->allocator;
+
+    allocator_free(&allocator, (*queue)->cells, (*queue)->capacity * (*queue)->cell_size);
+    allocator_free(&allocator, *queue, sizeof(mpmc_queue_t));
+    *queue = NULL;
+}
+
+bool mpmc_queue_try_enqueue(mpmc_queue_t *queue, const void *data)
+{
+    if (queue == NULL || data == NULL) {
+        return false;
+    }
+
+    mpmc_cell_t *cell;
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        cell = mpmc_queue_cell(queue, pos);
+
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+        if (diff == 0) {
+            // On failure the CAS reloads pos, so the loop retries right away
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The cell still holds the element of the previous lap
+            return false;
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(cell->data, data, queue->data_size);
+
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+    return true;
+}
+
+bool mpmc_queue_try_dequeue(mpmc_queue_t *queue, void *data)
+{
+    if (queue == NULL || data == NULL) {
+        return false;
+    }
+
+    mpmc_cell_t *cell;
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+        cell = mpmc_queue_cell(queue, pos);
+
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // No producer has filled the cell yet
+            return false;
+        } else {
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(data, cell->data, queue->data_size);
+
+    atomic_store_explicit(&cell->sequence, pos + queue->capacity, memory_order_release);
+
+    return true;
+}
+
+size_t mpmc_queue_size(mpmc_queue_t *queue)
+{
+    if (queue == NULL) {
+        return 0;
+    }
+
+    size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+
+    // Both positions move between the two loads, so clamp the difference
+    if ((intptr_t)(tail - head) < 0) {
+        return 0;
+    }
+
+    return tail - head < queue->capacity ? tail - head : queue->capacity;
+}
+
+bool mpmc_queue_is_empty(mpmc_queue_t *queue)
+{
+    return mpmc_queue_size(queue) == 0;
+}
+
+void mpmc_queue_print(mpmc_queue_t *queue)
+{
+    if (queue == NULL || queue->print_function == NULL) {
+        return;
+    }
+
+    size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+
+    for (size_t pos = head; pos != tail; pos++) {
+        queue->print_function(mpmc_queue_cell(queue, pos)->data);
+    }
+}
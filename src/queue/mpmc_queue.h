@@ -0,0 +1,147 @@
+/**
+ * @file mpmc_queue.h
+ * @author Secareanu Filip
+ * @brief   This is the header file for the bounded multi-producer/multi-consumer queue.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines a bounded, lock-free queue that any number of threads can
+ * enqueue to and dequeue from at the same time. Elements follow the queue_t
+ * model: the client provides their size and optional free and print
+ * functions, and the queue copies them in and out of a power-of-two array of
+ * cells.
+ *
+ * Every cell carries a sequence number next to its element (D. Vyukov's
+ * bounded MPMC design). A producer claims the cell at the enqueue position
+ * once its sequence says the cell is free for that lap, with a single
+ * compare-and-swap on the position; it then writes the element and publishes
+ * it by advancing the sequence. Consumers do the same on the dequeue position.
+ * Producers and consumers therefore only contend among themselves, and never
+ * on a shared lock.
+ *
+ * Both operations are non-blocking: they fail instead of waiting when the
+ * queue is full or empty. Since many threads use the queue at once, outcomes
+ * are reported through return values instead of a shared error field.
+ * Creation, destruction and printing are not thread-safe.
+ */
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include "../common/error/error.h"
+#include "../common/generic/memory_utils.h"
+#include "../common/generic/container_utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/**
+ * @struct mpmc_queue
+ * @brief Represents a bounded multi-producer/multi-consumer queue.
+ *
+ * The padding keeps the enqueue and dequeue positions on different cache
+ * lines from each other and from the read-only fields.
+ */
+typedef struct mpmc_queue mpmc_queue_t;
+
+struct mpmc_queue {
+    unsigned char *cells; ///< Array of cells, each a sequence number followed by an element.
+    size_t cell_size; ///< Size in bytes of a cell.
+    size_t data_size; ///< Size in bytes of the data type stored in the queue.
+    size_t capacity; ///< Number of cells, always a power of two.
+    free_function_t free_function; ///< Function to free data elements.
+    print_function_t print_function; ///< Function to print data elements.
+    allocator_t allocator; ///< Allocator used for the queue and its cells.
+
+    unsigned char pad_shared[CACHE_LINE_SIZE]; ///< Separates the read-only fields from the enqueue position.
+
+    _Atomic size_t enqueue_pos; ///< Position of the next cell to be claimed by a producer.
+
+    unsigned char pad_enqueue[CACHE_LINE_SIZE]; ///< Separates the enqueue position from the dequeue position.
+
+    _Atomic size_t dequeue_pos; ///< Position of the next cell to be claimed by a consumer.
+
+    unsigned char pad_dequeue[CACHE_LINE_SIZE]; ///< Keeps the dequeue position clear of whatever follows.
+};
+
+/**
+ * @brief Creates and initializes a new MPMC queue.
+ *
+ * @param data_size Size in bytes of the data type to be stored in the queue.
+ * @param capacity Maximum number of elements, rounded up to a power of two (at least 2).
+ * @param free_function Optional function to free data elements.
+ * @param print_function Optional function to print data elements.
+ * @return Pointer to the newly created queue.
+ */
+mpmc_queue_t *mpmc_queue_create(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Creates and initializes a new MPMC queue that allocates through a custom allocator.
+ *
+ * @param data_size Size in bytes of the data type to be stored in the queue.
+ * @param capacity Maximum number of elements, rounded up to a power of two (at least 2).
+ * @param free_function Optional function to free data elements.
+ * @param print_function Optional function to print data elements.
+ * @param allocator Allocator copied into the queue, NULL for the default allocator.
+ * @return Pointer to the newly created queue.
+ */
+mpmc_queue_t *mpmc_queue_create_a(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Destroys a queue and frees its memory. No thread may use the queue anymore.
+ *
+ * @param queue Double pointer to the queue to be destroyed.
+ * @param flag Flags controlling how the remaining elements should be freed.
+ */
+void mpmc_queue_destroy(mpmc_queue_t **queue, container_flags_t flag);
+
+/**
+ * @brief Tries to enqueue a copy of an element.
+ *
+ * @param queue Pointer to the queue.
+ * @param data Pointer to the data to be enqueued.
+ * @return true on success, false if the queue is full.
+ */
+bool mpmc_queue_try_enqueue(mpmc_queue_t *queue, const void *data);
+
+/**
+ * @brief Tries to dequeue the front element into a caller buffer.
+ *
+ * @param queue Pointer to the queue.
+ * @param data Buffer of at least data_size bytes receiving the element.
+ * @return true on success, false if the queue is empty.
+ */
+bool mpmc_queue_try_dequeue(mpmc_queue_t *queue, void *data);
+
+/**
+ * @brief Retrieves the number of elements in the queue.
+ *
+ * Called while other threads are active, the result is only a snapshot.
+ *
+ * @param queue Pointer to the queue.
+ * @return Number of elements in the queue.
+ */
+size_t mpmc_queue_size(mpmc_queue_t *queue);
+
+/**
+ * @brief Checks if the queue is empty. Like mpmc_queue_size, this is a snapshot.
+ *
+ * @param queue Pointer to the queue.
+ * @return true if the queue is empty, false otherwise.
+ */
+bool mpmc_queue_is_empty(mpmc_queue_t *queue);
+
+/**
+ * @brief Prints the queue elements, front to rear. Not safe while other threads are active.
+ *
+ * @param queue Pointer to the queue.
+ */
+void mpmc_queue_print(mpmc_queue_t *queue);
+
+#endif // MPMC_QUEUE_H
@@ -11,20 +11,108 @@
 
 #include "queue.h"
 
+/*
+ * Rounds a requested capacity up to the next power of two, so positions can
+ * wrap around with a mask instead of a division.
+ */
+static size_t queue_round_capacity(size_t capacity)
+{
+    size_t rounded = 1;
+
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    return rounded;
+}
+
+// Capacity a queue of the given capacity shrinks to, halved but never under the floor
+static size_t queue_shrunk_capacity(queue_t *queue, size_t capacity)
+{
+    size_t floor = queue->policy.min_capacity > queue->reserved ? queue->policy.min_capacity : queue->reserved;
+
+    floor = queue_round_capacity(floor);
+
+    return capacity / 2 < floor ? floor : capacity / 2;
+}
+
+// Recomputes the size limits after the capacity or the policy changed
+static void queue_update_limits(queue_t *queue)
+{
+    queue->grow_at = growth_policy_grow_at(&queue->policy, queue->capacity);
+    queue->shrink_below = growth_policy_shrink_below(&queue->policy, queue->capacity, queue_shrunk_capacity(queue, queue->capacity));
+}
+
+static void *queue_slot(queue_t *queue, size_t index)
+{
+    return (unsigned char *)queue->data + (index & (queue->capacity - 1)) * queue->data_size;
+}
+
+/*
+ * Copies the first count elements, front to rear, into a contiguous array. The
+ * live range wraps around the end of the buffer at most once, so two copies
+ * suffice.
+ */
+static void queue_copy_out(queue_t *queue, void *array, size_t count)
+{
+    size_t first = queue->capacity - queue->front;
+
+    if (first > count) {
+        first = count;
+    }
+
+    memcpy(array, queue_slot(queue, queue->front), first * queue->data_size);
+    memcpy((unsigned char *)array + first * queue->data_size, queue->data, (count - first) * queue->data_size);
+}
+
+/*
+ * Copies count elements from a contiguous array behind the rear, in at most
+ * two pieces. The buffer must have room for them.
+ */
+static void queue_copy_in(queue_t *queue, const void *array, size_t count)
+{
+    size_t first = queue->capacity - queue->rear;
+
+    if (first > count) {
+        first = count;
+    }
+
+    memcpy(queue_slot(queue, queue->rear), array, first * queue->data_size);
+    memcpy(queue->data, (const unsigned char *)array + first * queue->data_size, (count - first) * queue->data_size);
+}
+
 queue_t *queue_create(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function)
 {
-    queue_t *queue = SAFE_CALLOC(1, sizeof(queue_t));
+    return queue_create_a(data_size, capacity, grow_treshold, shrink_treshold, free_function, print_function, NULL);
+}
+
+queue_t *queue_create_a(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    queue_t *queue = ALLOCATOR_CALLOC(allocator, 1, sizeof(queue_t));
+
+    queue->allocator = *allocator;
+
+    capacity = queue_round_capacity(capacity);
 
-    queue->data = SAFE_CALLOC(capacity, data_size);
+    queue->data = ALLOCATOR_CALLOC(allocator, capacity, data_size);
 
-    queue->front = SIZE_MAX;
+    queue->front = 0;
     queue->rear = 0;
     queue->data_size = data_size;
     queue->size = 0;
     queue->capacity = capacity;
 
-    queue->grow_treshold = grow_treshold;
-    queue->shrink_treshold = shrink_treshold;
+    queue->policy.grow_treshold = grow_treshold;
+    queue->policy.shrink_treshold = shrink_treshold;
+    queue->policy.growth_factor = GROWTH_FACTOR_2X;
+    queue->policy.min_capacity = 1;
+    queue->reserved = 0;
+
+    queue_update_limits(queue);
 
     queue->error = ERROR_NONE;
 
@@ -42,13 +130,15 @@ void queue_destroy(queue_t **queue, container_flags_t flag)
     if (flag == CF_FREE_DATA && (*queue)->free_function != NULL)
     {
         for (size_t i = 0; i < (*queue)->size; i++) {
-            void *source = (*queue)->data + (((*queue)->front + i) * (*queue)->data_size);
+            void *source = queue_slot(*queue, (*queue)->front + i);
             (*queue)->free_function(source);
         }
     }
 
-    free((*queue)->data);
-    free(*queue);
+    allocator_t allocator = (*queue)->allocator;
+
+    allocator_free(&allocator, (*queue)->data, (*queue)->capacity * (*queue)->data_size);
+    allocator_free(&allocator, *queue, sizeof(queue_t));
     *queue = NULL;
 }
 
@@ -63,18 +153,14 @@ void queue_enqueue(queue_t *queue, void *data)
         return;
     }
 
-    if ((float)queue->size / (float)queue->capacity >= queue->grow_treshold) {
+    if (queue->size >= queue->grow_at) {
         queue_resize(queue, queue->capacity * 2);
     }
 
-    if (queue->front == SIZE_MAX) {
-        queue->front = 0;
-    }
-
-    void *source = queue->data + (queue->rear * queue->data_size);
+    void *source = queue_slot(queue, queue->rear);
     memcpy(source, data, queue->data_size);
 
-    queue->rear++;
+    queue->rear = (queue->rear + 1) & (queue->capacity - 1);
     queue->size++;
 
     queue->error = ERROR_NONE;
@@ -91,20 +177,16 @@ void *queue_dequeue(queue_t *queue)
         return NULL;
     }
 
-    if ((float)queue->size / queue->capacity <= queue->shrink_treshold) {
-        queue_resize(queue, queue->capacity / 2);
+    // Shrink while the element still counts, so it is moved along with the rest
+    if (queue->size - 1 < queue->shrink_below) {
+        queue_resize(queue, queue_shrunk_capacity(queue, queue->capacity));
     }
 
-    void *data = queue->data + (queue->front * queue->data_size);
+    void *data = queue_slot(queue, queue->front);
 
-    queue->front++;
+    queue->front = (queue->front + 1) & (queue->capacity - 1);
     queue->size--;
 
-    if (queue->size == 0) {
-        queue->front = SIZE_MAX;
-        queue->rear = 0;
-    }
-
     queue->error = ERROR_NONE;
 
     return data;
@@ -123,7 +205,7 @@ void *queue_front(queue_t *queue)
 
     void *data = SAFE_CALLOC(1, queue->data_size);
 
-    void *source = queue->data + (queue->front * queue->data_size);
+    void *source = queue_slot(queue, queue->front);
     memcpy(data, source, queue->data_size);
 
     queue->error = ERROR_NONE;
@@ -131,6 +213,222 @@ void *queue_front(queue_t *queue)
     return data;
 }
 
+bool queue_dequeue_into(queue_t *queue, void *data)
+{
+    if (queue == NULL) {
+        return false;
+    }
+
+    if (data == NULL) {
+        queue->error = ERROR_INVALID_DATA;
+        return false;
+    }
+
+    if (queue->size == 0) {
+        queue->error = ERROR_EMPTY;
+        return false;
+    }
+
+    // Copy first: shrinking moves the elements to a new buffer
+    memcpy(data, queue_slot(queue, queue->front), queue->data_size);
+
+    queue->front = (queue->front + 1) & (queue->capacity - 1);
+    queue->size--;
+
+    if (queue->size < queue->shrink_below) {
+        queue_resize(queue, queue_shrunk_capacity(queue, queue->capacity));
+    }
+
+    queue->error = ERROR_NONE;
+
+    return true;
+}
+
+const void *queue_front_ref(queue_t *queue)
+{
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    if (queue->size == 0) {
+        queue->error = ERROR_EMPTY;
+        return NULL;
+    }
+
+    queue->error = ERROR_NONE;
+
+    return queue_slot(queue, queue->front);
+}
+
+bool queue_front_into(queue_t *queue, void *data)
+{
+    if (queue == NULL) {
+        return false;
+    }
+
+    if (data == NULL) {
+        queue->error = ERROR_INVALID_DATA;
+        return false;
+    }
+
+    if (queue->size == 0) {
+        queue->error = ERROR_EMPTY;
+        return false;
+    }
+
+    memcpy(data, queue_slot(queue, queue->front), queue->data_size);
+
+    queue->error = ERROR_NONE;
+
+    return true;
+}
+
+void queue_enqueue_n(queue_t *queue, const void *array, size_t count)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    if (array == NULL) {
+        queue->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    if (count == 0) {
+        queue->error = ERROR_NONE;
+        return;
+    }
+
+    // Grow once, to the capacity count single enqueues would have reached
+    size_t capacity = queue->capacity;
+    size_t size = queue->size;
+    size_t end = queue->size + count;
+
+    while (size < end) {
+        size_t grow_at = growth_policy_grow_at(&queue->policy, capacity);
+
+        if (size >= grow_at) {
+            capacity *= 2;
+            size++;
+        } else {
+            size = grow_at < end ? grow_at : end;
+        }
+    }
+
+    if (capacity != queue->capacity) {
+        queue_resize(queue, capacity);
+    }
+
+    queue_copy_in(queue, array, count);
+
+    queue->rear = (queue->rear + count) & (queue->capacity - 1);
+    queue->size += count;
+
+    queue->error = ERROR_NONE;
+}
+
+size_t queue_dequeue_n(queue_t *queue, void *array, size_t count)
+{
+    if (queue == NULL) {
+        return 0;
+    }
+
+    if (array == NULL) {
+        queue->error = ERROR_INVALID_DATA;
+        return 0;
+    }
+
+    if (count > queue->size) {
+        count = queue->size;
+    }
+
+    queue_copy_out(queue, array, count);
+
+    queue->front = (queue->front + count) & (queue->capacity - 1);
+    queue->size -= count;
+
+    // Shrink once, as far as single dequeues would have
+    size_t capacity = queue->capacity;
+    size_t shrunk = queue_shrunk_capacity(queue, capacity);
+
+    while (queue->size < growth_policy_shrink_below(&queue->policy, capacity, shrunk)) {
+        capacity = shrunk;
+        shrunk = queue_shrunk_capacity(queue, capacity);
+    }
+
+    if (capacity != queue->capacity) {
+        queue_resize(queue, capacity);
+    }
+
+    queue->error = ERROR_NONE;
+
+    return count;
+}
+
+void queue_set_growth_policy(queue_t *queue, const growth_policy_t *policy)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    if (policy == NULL) {
+        queue->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    queue->policy = *policy;
+
+    if (queue->capacity < queue->policy.min_capacity) {
+        queue_resize(queue, queue->policy.min_capacity);
+    } else {
+        queue_update_limits(queue);
+    }
+
+    queue->error = ERROR_NONE;
+}
+
+void queue_reserve(queue_t *queue, size_t count)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    size_t capacity = queue_round_capacity(count);
+
+    while (queue->policy.grow_treshold > 0.0f && growth_policy_grow_at(&queue->policy, capacity) < count) {
+        capacity *= 2;
+    }
+
+    queue->reserved = capacity;
+
+    if (capacity > queue->capacity) {
+        queue_resize(queue, capacity);
+    } else {
+        queue_update_limits(queue);
+    }
+
+    queue->error = ERROR_NONE;
+}
+
+void queue_shrink_to_fit(queue_t *queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    size_t capacity = queue_round_capacity(queue->size > queue->policy.min_capacity ? queue->size : queue->policy.min_capacity);
+
+    queue->reserved = 0;
+
+    if (capacity < queue->capacity) {
+        queue_resize(queue, capacity);
+    } else {
+        queue_update_limits(queue);
+    }
+
+    queue->error = ERROR_NONE;
+}
+
 void queue_clear(queue_t *queue, container_flags_t flag)
 {
     if (queue == NULL) {
@@ -138,18 +436,16 @@ void queue_clear(queue_t *queue, container_flags_t flag)
     }
 
     if (flag == CF_FREE_DATA && queue->free_function) {
-        while (queue->size > 0) {
-            void *source = queue->data + (queue->front * queue->data_size);
+        for (size_t i = 0; i < queue->size; i++) {
+            void *source = queue_slot(queue, queue->front + i);
             queue->free_function(source);
-            queue->front++;
-            queue->size--;
         }
-    } else {
-        queue->front = SIZE_MAX;
-        queue->rear = 0;
-        queue->size = 0;
     }
 
+    queue->front = 0;
+    queue->rear = 0;
+    queue->size = 0;
+
     queue->error = ERROR_NONE;
 }
 
@@ -182,8 +478,7 @@ void queue_to_array(queue_t *queue, void *array)
         return;
     }
 
-    void *source = queue->data + (queue->front * queue->data_size);
-    memcpy(array, source, queue->data_size * queue->size);
+    queue_copy_out(queue, array, queue->size);
 
     queue->error = ERROR_NONE;
 }
@@ -202,14 +497,18 @@ void queue_from_array(queue_t *queue, void *array, size_t array_size)
     queue_clear(queue, CF_NONE);
 
     if (array_size > queue->capacity) {
-        queue->data = SAFE_REALLOC(queue->data, array_size * queue->data_size);
-        queue->capacity = array_size;
+        size_t new_capacity = queue_round_capacity(array_size);
+
+        queue->data = ALLOCATOR_REALLOC(&queue->allocator, queue->data, queue->capacity * queue->data_size, new_capacity * queue->data_size);
+        queue->capacity = new_capacity;
+
+        queue_update_limits(queue);
     }
 
     memcpy(queue->data, array, array_size * queue->data_size);
 
     queue->front = 0;
-    queue->rear = array_size;
+    queue->rear = array_size & (queue->capacity - 1);
     queue->size = array_size;
 
     queue->error = ERROR_NONE;
@@ -221,18 +520,25 @@ void queue_resize(queue_t *queue, size_t new_capacity)
         return;
     }
 
-    void *new_data = SAFE_CALLOC(new_capacity, queue->data_size);
+    // The buffer must stay a power of two that can hold every element
+    if (new_capacity < queue->size) {
+        new_capacity = queue->size;
+    }
+    new_capacity = queue_round_capacity(new_capacity);
+
+    void *new_data = ALLOCATOR_CALLOC(&queue->allocator, new_capacity, queue->data_size);
 
-    void *source = queue->data + (queue->front * queue->data_size);
-    memcpy(new_data, source, queue->data_size * queue->size);
+    queue_copy_out(queue, new_data, queue->size);
 
-    free(queue->data);
+    allocator_free(&queue->allocator, queue->data, queue->capacity * queue->data_size);
 
     queue->data = new_data;
     queue->capacity = new_capacity;
 
     queue->front = 0;
-    queue->rear = queue->size;
+    queue->rear = queue->size & (new_capacity - 1);
+
+    queue_update_limits(queue);
 
     queue->error = ERROR_NONE;
 }
@@ -248,12 +554,8 @@ void queue_print(queue_t *queue)
         return;
     }
 
-    size_t front = queue->front;
-
-    while (front < queue->rear) {
-        void *source = queue->data + front * queue->data_size;
+    for (size_t i = 0; i < queue->size; i++) {
+        void *source = queue_slot(queue, queue->front + i);
         queue->print_function(source);
-
-        front++;
     }
 }
@@ -8,8 +8,18 @@
  * @copyright Copyright (c) 2023
  * This file provides the structure definition, function prototypes, and
  * documentation for a generic queue data structure. The queue is implemented
- * using a dynamic array, allowing it to resize based on the number of elements
- * and specified growth and shrink thresholds. 
+ * as a circular buffer over a dynamic array, allowing it to resize based on
+ * the number of elements and specified growth and shrink thresholds. The
+ * capacity is always a power of two, so the front and rear positions wrap
+ * around with a mask, and slots freed by dequeues are reused by later
+ * enqueues: a queue whose depth stays constant never reallocates.
+ *
+ * The thresholds and minimum capacity of a growth_policy_t are turned into
+ * integer size limits whenever the capacity changes, so enqueue and dequeue
+ * only compare integers, and the shrink limit leaves a band under the growth
+ * limit so a queue oscillating around one depth does not keep reallocating.
+ * The capacity being a power of two, the queue always doubles and halves,
+ * whatever the policy's growth factor.
  *
  * The queue is designed to be generic, meaning it can store elements of any 
  * data type. To accommodate for different data types, the client code must 
@@ -43,6 +53,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <assert.h>
 
 /**
  * @struct queue
@@ -55,17 +66,20 @@
 typedef struct queue queue_t;
 
 struct queue {
-    void *data; ///< Pointer to the dynamic array storing the queue elements.
-    size_t front; ///< Index of the front of the queue.
-    size_t rear; ///< Index of the rear of the queue.
+    void *data; ///< Pointer to the circular buffer storing the queue elements.
+    size_t front; ///< Index of the front element in the buffer.
+    size_t rear; ///< Index of the slot the next element is written to.
     size_t data_size; ///< Size in bytes of the data type stored in the queue.
     size_t size; ///< Current number of elements in the queue.
-    size_t capacity; ///< Current capacity of the queue.
-    float grow_treshold; ///< Load factor threshold to trigger capacity growth.
-    float shrink_treshold; ///< Load factor threshold to trigger capacity shrinking.
+    size_t capacity; ///< Current capacity of the queue, always a power of two.
+    growth_policy_t policy; ///< How the queue grows and shrinks with its load.
+    size_t grow_at; ///< An enqueue into a queue of this size grows it first.
+    size_t shrink_below; ///< A dequeue leaving fewer elements than this shrinks the queue, 0 for never.
+    size_t reserved; ///< Capacity set by queue_reserve that shrinking keeps, 0 if none.
     container_error_t error; ///< Error status of the last queue operation.
     free_function_t free_function; ///< Function to free data elements.
     print_function_t print_function; ///< Function to print data elements.
+    allocator_t allocator; ///< Allocator used for the queue and its dynamic array.
 };
 
 /**
@@ -75,7 +89,7 @@ struct queue {
  * growth and shrink thresholds, and optional custom memory management functions.
  *
  * @param data_size Size in bytes of the data type to be stored in the queue.
- * @param capacity Initial capacity of the queue.
+ * @param capacity Initial capacity of the queue, rounded up to a power of two.
  * @param grow_treshold Load factor threshold to trigger capacity growth.
  * @param shrink_treshold Load factor threshold to trigger capacity shrinking.
  * @param free_function Optional function to free data elements.
@@ -84,6 +98,20 @@ struct queue {
  */
 queue_t *queue_create(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function);
 
+/**
+ * @brief Creates and initializes a new queue that allocates through a custom allocator.
+ *
+ * @param data_size Size in bytes of the data type to be stored in the queue.
+ * @param capacity Initial capacity of the queue, rounded up to a power of two.
+ * @param grow_treshold Load factor threshold to trigger capacity growth.
+ * @param shrink_treshold Load factor threshold to trigger capacity shrinking.
+ * @param free_function Optional function to free data elements.
+ * @param print_function Optional function to print data elements.
+ * @param allocator Allocator copied into the queue, NULL for the default allocator.
+ * @return Pointer to the newly created queue.
+ */
+queue_t *queue_create_a(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
 /**
  * @brief Destroys a queue and frees its memory.
  *
@@ -111,7 +139,8 @@ void queue_enqueue(queue_t *queue, void *data);
  *
  * Removes and returns the element at the front of the queue. If the queue is
  * sufficiently empty after the dequeue operation, it may be resized to save
- * memory.
+ * memory; the element is moved along in that case. The returned pointer refers
+ * to the queue's buffer and stays valid until the next enqueue or resize.
  *
  * @param queue Pointer to the queue.
  * @return Pointer to the dequeued data, or NULL if the queue is empty.
@@ -121,11 +150,106 @@ void *queue_dequeue(queue_t *queue);
 /**
  * @brief Retrieves, but does not remove, the front element of the queue.
  *
+ * The element is returned as a copy allocated with the system allocator,
+ * which the caller must free(). queue_front_ref and queue_front_into avoid
+ * the allocation.
+ *
  * @param queue Pointer to the queue.
  * @return Pointer to the front data, or NULL if the queue is empty.
  */
 void *queue_front(queue_t *queue);
 
+/**
+ * @brief Dequeues the front element into a caller buffer.
+ *
+ * Unlike queue_dequeue, the element is copied out before the queue may
+ * shrink, so nothing refers to the queue's buffer afterwards.
+ *
+ * @param queue Pointer to the queue.
+ * @param data Buffer of at least data_size bytes receiving the element.
+ * @return true on success, false if the queue is empty or data is NULL.
+ */
+bool queue_dequeue_into(queue_t *queue, void *data);
+
+/**
+ * @brief Returns a pointer to the front element, inside the queue's own buffer.
+ *
+ * Nothing is allocated or copied. The pointer is borrowed: it stays valid
+ * until the next operation that modifies the queue.
+ *
+ * @param queue Pointer to the queue.
+ * @return Pointer to the front data, or NULL if the queue is empty.
+ */
+const void *queue_front_ref(queue_t *queue);
+
+/**
+ * @brief Copies, but does not remove, the front element into a caller buffer.
+ *
+ * @param queue Pointer to the queue.
+ * @param data Buffer of at least data_size bytes receiving the element.
+ * @return true on success, false if the queue is empty or data is NULL.
+ */
+bool queue_front_into(queue_t *queue, void *data);
+
+/**
+ * @brief Enqueues count elements from an array, array[0] first.
+ *
+ * The buffer is grown once, to what count single enqueues would have reached,
+ * and the elements are moved with one copy, or two where the ring wraps.
+ *
+ * @param queue Pointer to the queue.
+ * @param array Pointer to the elements to enqueue.
+ * @param count Number of elements to enqueue.
+ */
+void queue_enqueue_n(queue_t *queue, const void *array, size_t count);
+
+/**
+ * @brief Dequeues up to count elements, front first, into an array.
+ *
+ * The elements are moved with one copy, or two where the ring wraps, and the
+ * buffer shrinks at most once afterwards.
+ *
+ * @param queue Pointer to the queue.
+ * @param array Buffer with room for count elements.
+ * @param count Largest number of elements to dequeue.
+ * @return The number of elements dequeued, less than count if the queue ran out.
+ */
+size_t queue_dequeue_n(queue_t *queue, void *array, size_t count);
+
+/**
+ * @brief Replaces the growth policy of the queue.
+ *
+ * The growth factor is ignored, the queue always doubling and halving. The
+ * queue grows to the policy's minimum capacity, rounded up to a power of two,
+ * right away if it is under it. A queue created with queue_create has a
+ * minimum capacity of 1.
+ *
+ * @param queue Pointer to the queue.
+ * @param policy The new policy.
+ */
+void queue_set_growth_policy(queue_t *queue, const growth_policy_t *policy);
+
+/**
+ * @brief Makes room for count elements, so enqueuing up to count elements does not resize the queue.
+ *
+ * The capacity is also kept from then on: dequeuing never shrinks the queue
+ * under it, until queue_shrink_to_fit.
+ *
+ * @param queue Pointer to the queue.
+ * @param count Number of elements the queue must hold without resizing.
+ */
+void queue_reserve(queue_t *queue, size_t count);
+
+/**
+ * @brief Shrinks the capacity to the smallest power of two holding the elements.
+ *
+ * Drops any capacity kept by queue_reserve. The capacity never goes under the
+ * policy's minimum.
+ *
+ * @param queue Pointer to the queue.
+ */
+void queue_shrink_to_fit(queue_t *queue);
+
 /**
  * @brief Clears all elements from the queue.
  *
@@ -154,7 +278,7 @@ bool queue_is_empty(queue_t *queue);
 size_t queue_size(queue_t *queue);
 
 /**
- * @brief Copies the queue elements to an array.
+ * @brief Copies the queue elements to an array, front to rear.
  *
  * @param queue Pointer to the queue.
  * @param array Pointer to the array where the queue elements will be copied.
@@ -173,6 +297,10 @@ void queue_from_array(queue_t *queue, void *array, size_t array_size);
 /**
  * @brief Resizes the queue to a new capacity.
  *
+ * The capacity is rounded up to a power of two and never drops below the
+ * number of stored elements. The elements are moved to the start of the new
+ * buffer.
+ *
  * @param queue Pointer to the queue.
  * @param new_capacity The new capacity for the queue.
  */
@@ -187,4 +315,70 @@ void queue_resize(queue_t *queue, size_t new_capacity);
  */
 void queue_print(queue_t *queue);
 
+/**
+ * @brief Defines typed, inline queue operations for elements of type T, prefixed with name.
+ *
+ * The generated functions work on ordinary queue_t instances holding
+ * sizeof(T)-byte elements, so typed and void * calls can be mixed on the same
+ * queue. With the element size known at compile time, an enqueue or dequeue
+ * that does not resize the ring is a compare against the queue's size limits,
+ * a plain store or load and a masked index update; the ones that do resize go
+ * through the out-of-line functions. For DEFINE_QUEUE(int_queue, int):
+ *
+ *   queue_t *int_queue_create(size_t capacity, float grow_treshold, float shrink_treshold);
+ *   void int_queue_enqueue(queue_t *queue, int value);
+ *   bool int_queue_dequeue(queue_t *queue, int *value);
+ *   bool int_queue_front(queue_t *queue, int *value);
+ *
+ * dequeue and front return false on an empty queue, like queue_dequeue_into.
+ */
+#define DEFINE_QUEUE(name, T)                                                                       \
+static inline queue_t *name##_create(size_t capacity, float grow_treshold, float shrink_treshold)  \
+{                                                                                                   \
+    return queue_create(sizeof(T), capacity, grow_treshold, shrink_treshold, NULL, NULL);           \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_enqueue(queue_t *queue, T value)                                          \
+{                                                                                                   \
+    assert(queue->data_size == sizeof(T));                                                          \
+                                                                                                    \
+    if (queue->size < queue->grow_at) {                                                             \
+        ((T *)queue->data)[queue->rear] = value;                                                    \
+        queue->rear = (queue->rear + 1) & (queue->capacity - 1);                                    \
+        queue->size++;                                                                              \
+        queue->error = ERROR_NONE;                                                                  \
+    } else {                                                                                        \
+        queue_enqueue(queue, &value);                                                               \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_dequeue(queue_t *queue, T *value)                                         \
+{                                                                                                   \
+    assert(queue->data_size == sizeof(T));                                                          \
+                                                                                                    \
+    if (queue->size > queue->shrink_below) {                                                        \
+        *value = ((T *)queue->data)[queue->front];                                                  \
+        queue->front = (queue->front + 1) & (queue->capacity - 1);                                  \
+        queue->size--;                                                                              \
+        queue->error = ERROR_NONE;                                                                  \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    return queue_dequeue_into(queue, value);                                                        \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_front(queue_t *queue, T *value)                                           \
+{                                                                                                   \
+    assert(queue->data_size == sizeof(T));                                                          \
+                                                                                                    \
+    if (queue->size == 0) {                                                                         \
+        queue->error = ERROR_EMPTY;                                                                 \
+        return false;                                                                               \
+    }                                                                                               \
+                                                                                                    \
+    *value = ((T *)queue->data)[queue->front];                                                      \
+    queue->error = ERROR_NONE;                                                                      \
+    return true;                                                                                    \
+}
+
 #endif // QUEUE_H
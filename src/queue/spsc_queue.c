@@ -0,0 +1,239 @@
+/**
+ * @file spsc_queue.c
+ * @author Secareanu Filip
+ * @brief   This is the implementation for the single-producer/single-consumer queue.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "spsc_queue.h"
+
+/*
+ * head and tail count elements since creation and are only reduced to a slot
+ * with the mask, so tail - head is the number of stored elements even after
+ * the counters wrap around.
+ */
+static void *spsc_queue_slot(spsc_queue_t *queue, size_t index)
+{
+    return queue->data + (index & (queue->capacity - 1)) * queue->data_size;
+}
+
+static void spsc_queue_copy_in(spsc_queue_t *queue, size_t index, const void *array, size_t count)
+{
+    size_t first = queue->capacity - (index & (queue->capacity - 1));
+
+    if (first > count) {
+        first = count;
+    }
+
+    memcpy(spsc_queue_slot(queue, index), array, first * queue->data_size);
+    memcpy(queue->data, (const unsigned char *)array + first * queue->data_size, (count - first) * queue->data_size);
+}
+
+static void spsc_queue_copy_out(spsc_queue_t *queue, size_t index, void *array, size_t count)
+{
+    size_t first = queue->capacity - (index & (queue->capacity - 1));
+
+    if (first > count) {
+        first = count;
+    }
+
+    memcpy(array, spsc_queue_slot(queue, index), first * queue->data_size);
+    memcpy((unsigned char *)array + first * queue->data_size, queue->data, (count - first) * queue->data_size);
+}
+
+spsc_queue_t *spsc_queue_create(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function)
+{
+    return spsc_queue_create_a(data_size, capacity, free_function, print_function, NULL);
+}
+
+spsc_queue_t *spsc_queue_create_a(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    spsc_queue_t *queue = ALLOCATOR_CALLOC(allocator, 1, sizeof(spsc_queue_t));
+
+    queue->allocator = *allocator;
+
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    queue->data = ALLOCATOR_ALLOC(allocator, rounded * data_size);
+    queue->data_size = data_size;
+    queue->capacity = rounded;
+
+    queue->free_function = free_function;
+    queue->print_function = print_function;
+
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->head_cache = 0;
+    queue->tail_cache = 0;
+
+    return queue;
+}
+
+void spsc_queue_destroy(spsc_queue_t **queue, container_flags_t flag)
+{
+    if (*queue == NULL) {
+        return;
+    }
+
+    if (flag == CF_FREE_DATA && (*queue)->free_function != NULL) {
+        size_t head = atomic_load_explicit(&(*queue)->head, memory_order_acquire);
+        size_t tail = atomic_load_explicit(&(*queue)->tail, memory_order_acquire);
+
+        for (size_t i = head; i != tail; i++) {
+            (*queue)->free_function(spsc_queue_slot(*queue, i));
+        }
+    }
+
+    allocator_t allocator = (*queue)->allocator;
+
+    allocator_free(&allocator, (*queue)->data, (*queue)->capacity * (*queue)->data_size);
+    allocator_free(&allocator, *queue, sizeof(spsc_queue_t));
+    *queue = NULL;
+}
+
+bool spsc_queue_enqueue(spsc_queue_t *queue, const void *data)
+{
+    if (queue == NULL || data == NULL) {
+        return false;
+    }
+
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    if (tail - queue->head_cache == queue->capacity) {
+        queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+        if (tail - queue->head_cache == queue->capacity) {
+            return false;
+        }
+    }
+
+    memcpy(spsc_queue_slot(queue, tail), data, queue->data_size);
+
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+bool spsc_queue_dequeue(spsc_queue_t *queue, void *data)
+{
+    if (queue == NULL || data == NULL) {
+        return false;
+    }
+
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    if (head == queue->tail_cache) {
+        queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+        if (head == queue->tail_cache) {
+            return false;
+        }
+    }
+
+    memcpy(data, spsc_queue_slot(queue, head), queue->data_size);
+
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+size_t spsc_queue_enqueue_n(spsc_queue_t *queue, const void *array, size_t count)
+{
+    if (queue == NULL || array == NULL) {
+        return 0;
+    }
+
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t free_slots = queue->capacity - (tail - queue->head_cache);
+
+    if (free_slots < count) {
+        queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+        free_slots = queue->capacity - (tail - queue->head_cache);
+    }
+
+    if (count > free_slots) {
+        count = free_slots;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    spsc_queue_copy_in(queue, tail, array, count);
+
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+
+    return count;
+}
+
+size_t spsc_queue_dequeue_n(spsc_queue_t *queue, void *array, size_t count)
+{
+    if (queue == NULL || array == NULL) {
+        return 0;
+    }
+
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t available = queue->tail_cache - head;
+
+    if (available < count) {
+        queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->tail_cache - head;
+    }
+
+    if (count > available) {
+        count = available;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    spsc_queue_copy_out(queue, head, array, count);
+
+    atomic_store_explicit(&queue->head, head + count, memory_order_release);
+
+    return count;
+}
+
+size_t spsc_queue_size(spsc_queue_t *queue)
+{
+    if (queue == NULL) {
+        return 0;
+    }
+
+    // Load head first: tail can only move forward meanwhile, never behind it
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    return tail - head;
+}
+
+bool spsc_queue_is_empty(spsc_queue_t *queue)
+{
+    return spsc_queue_size(queue) == 0;
+}
+
+void spsc_queue_print(spsc_queue_t *queue)
+{
+    if (queue == NULL || queue->print_function == NULL) {
+        return;
+    }
+
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    for (size_t i = head; i != tail; i++) {
+        queue->print_function(spsc_queue_slot(queue, i));
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * @file spsc_queue.h
+ * @author Secareanu Filip
+ * @brief   This is the header file for the single-producer/single-consumer queue.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines a bounded, lock-free queue for exactly one producer thread
+ * and one consumer thread. Elements follow the same model as queue_t: the
+ * client provides their size and optional free and print functions, and the
+ * queue copies them in and out of a power-of-two circular buffer.
+ *
+ * The producer owns the tail index and the consumer owns the head index. Each
+ * index is published with a C11 release store and read by the other side with
+ * an acquire load, and the two live on separate cache lines. Every side also
+ * keeps a private copy of the other side's index and only reloads it when the
+ * queue looks full (or empty), so in steady state an operation touches a
+ * single shared cache line. The batch variants copy a whole span and publish
+ * it with one store.
+ *
+ * Since two threads use the queue at once, operations report their outcome
+ * through their return value instead of a shared error field. Creation,
+ * destruction and printing are not thread-safe.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include "../common/error/error.h"
+#include "../common/generic/memory_utils.h"
+#include "../common/generic/container_utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/**
+ * @struct spsc_queue
+ * @brief Represents a bounded single-producer/single-consumer queue.
+ *
+ * The padding keeps the producer's and the consumer's fields on different
+ * cache lines from each other and from the read-only fields.
+ */
+typedef struct spsc_queue spsc_queue_t;
+
+struct spsc_queue {
+    unsigned char *data; ///< Pointer to the circular buffer storing the queue elements.
+    size_t data_size; ///< Size in bytes of the data type stored in the queue.
+    size_t capacity; ///< Number of slots, always a power of two.
+    free_function_t free_function; ///< Function to free data elements.
+    print_function_t print_function; ///< Function to print data elements.
+    allocator_t allocator; ///< Allocator used for the queue and its buffer.
+
+    unsigned char pad_shared[CACHE_LINE_SIZE]; ///< Separates the read-only fields from the producer's.
+
+    _Atomic size_t tail; ///< Number of elements ever enqueued, written by the producer.
+    size_t head_cache; ///< Producer's last seen value of head.
+
+    unsigned char pad_producer[CACHE_LINE_SIZE]; ///< Separates the producer's fields from the consumer's.
+
+    _Atomic size_t head; ///< Number of elements ever dequeued, written by the consumer.
+    size_t tail_cache; ///< Consumer's last seen value of tail.
+
+    unsigned char pad_consumer[CACHE_LINE_SIZE]; ///< Keeps the consumer's fields clear of whatever follows.
+};
+
+/**
+ * @brief Creates and initializes a new SPSC queue.
+ *
+ * @param data_size Size in bytes of the data type to be stored in the queue.
+ * @param capacity Maximum number of elements, rounded up to a power of two.
+ * @param free_function Optional function to free data elements.
+ * @param print_function Optional function to print data elements.
+ * @return Pointer to the newly created queue.
+ */
+spsc_queue_t *spsc_queue_create(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Creates and initializes a new SPSC queue that allocates through a custom allocator.
+ *
+ * @param data_size Size in bytes of the data type to be stored in the queue.
+ * @param capacity Maximum number of elements, rounded up to a power of two.
+ * @param free_function Optional function to free data elements.
+ * @param print_function Optional function to print data elements.
+ * @param allocator Allocator copied into the queue, NULL for the default allocator.
+ * @return Pointer to the newly created queue.
+ */
+spsc_queue_t *spsc_queue_create_a(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Destroys a queue and frees its memory. Neither thread may use the queue anymore.
+ *
+ * @param queue Double pointer to the queue to be destroyed.
+ * @param flag Flags controlling how the remaining elements should be freed.
+ */
+void spsc_queue_destroy(spsc_queue_t **queue, container_flags_t flag);
+
+/**
+ * @brief Enqueues a copy of an element. Producer only.
+ *
+ * @param queue Pointer to the queue.
+ * @param data Pointer to the data to be enqueued.
+ * @return true on success, false if the queue is full.
+ */
+bool spsc_queue_enqueue(spsc_queue_t *queue, const void *data);
+
+/**
+ * @brief Dequeues the front element into a caller buffer. Consumer only.
+ *
+ * @param queue Pointer to the queue.
+ * @param data Buffer of at least data_size bytes receiving the element.
+ * @return true on success, false if the queue is empty.
+ */
+bool spsc_queue_dequeue(spsc_queue_t *queue, void *data);
+
+/**
+ * @brief Enqueues up to count elements from an array and publishes them at once. Producer only.
+ *
+ * @param queue Pointer to the queue.
+ * @param array Pointer to the elements to be enqueued.
+ * @param count Number of elements in the array.
+ * @return Number of elements enqueued, less than count if the queue filled up.
+ */
+size_t spsc_queue_enqueue_n(spsc_queue_t *queue, const void *array, size_t count);
+
+/**
+ * @brief Dequeues up to count elements into an array and releases their slots at once. Consumer only.
+ *
+ * @param queue Pointer to the queue.
+ * @param array Buffer with room for count elements.
+ * @param count Maximum number of elements to dequeue.
+ * @return Number of elements dequeued, less than count if the queue ran empty.
+ */
+size_t spsc_queue_dequeue_n(spsc_queue_t *queue, void *array, size_t count);
+
+/**
+ * @brief Retrieves the number of elements in the queue.
+ *
+ * Called while the other thread is active, the result may already be stale.
+ *
+ * @param queue Pointer to the queue.
+ * @return Number of elements in the queue.
+ */
+size_t spsc_queue_size(spsc_queue_t *queue);
+
+/**
+ * @brief Checks if the queue is empty. Like spsc_queue_size, this is a snapshot.
+ *
+ * @param queue Pointer to the queue.
+ * @return true if the queue is empty, false otherwise.
+ */
+bool spsc_queue_is_empty(spsc_queue_t *queue);
+
+/**
+ * @brief Prints the queue elements, front to rear. Not safe while either thread is active.
+ *
+ * @param queue Pointer to the queue.
+ */
+void spsc_queue_print(spsc_queue_t *queue);
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,333 @@
+/**
+ * @file thread_pool.c
+ * @author Secareanu Filip
+ * @brief   This is the source file for the work-stealing thread pool.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "thread_pool.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+/**
+ * @brief The shared state of one parallel_for call, living on the caller's stack.
+ */
+typedef struct thread_pool_range {
+    range_function_t function;      ///< Function run over every piece.
+    void *arg;                      ///< Argument passed to function.
+    size_t grain;                   ///< Largest number of indices in a piece.
+    _Atomic size_t remaining;       ///< Number of indices not processed yet.
+} thread_pool_range_t;
+
+// The worker running on this thread, NULL outside of a pool
+static _Thread_local thread_pool_worker_t *thread_pool_current;
+
+// State of the generator picking steal victims
+static _Thread_local uint64_t thread_pool_seed;
+
+static size_t thread_pool_random(size_t bound)
+{
+    uint64_t x = thread_pool_seed;
+
+    if (x == 0) {
+        x = ((uint64_t)(uintptr_t)&thread_pool_seed * 0x9E3779B97F4A7C15ULL) | 1;
+    }
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    thread_pool_seed = x;
+
+    return (size_t)(x % bound);
+}
+
+static thread_pool_worker_t *thread_pool_worker(thread_pool_t *pool)
+{
+    thread_pool_worker_t *worker = thread_pool_current;
+
+    return worker != NULL && worker->pool == pool ? worker : NULL;
+}
+
+/*
+ * Wakes one parked worker, if there is any. The bump of signal and the check
+ * of sleepers pair with the opposite order in thread_pool_park, so either the
+ * submitter sees the worker going to sleep or the worker sees the new signal.
+ */
+static void thread_pool_notify(thread_pool_t *pool)
+{
+    atomic_fetch_add_explicit(&pool->signal, 1, memory_order_seq_cst);
+
+    if (atomic_load_explicit(&pool->sleepers, memory_order_seq_cst) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void thread_pool_park(thread_pool_t *pool, uint64_t ticket)
+{
+    atomic_fetch_add_explicit(&pool->sleepers, 1, memory_order_seq_cst);
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (atomic_load_explicit(&pool->signal, memory_order_seq_cst) == ticket && !atomic_load_explicit(&pool->stop, memory_order_acquire)) {
+        pthread_cond_wait(&pool->wake, &pool->lock);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    atomic_fetch_sub_explicit(&pool->sleepers, 1, memory_order_relaxed);
+}
+
+static bool thread_pool_steal(thread_pool_t *pool, thread_pool_worker_t *worker, thread_pool_task_t *task)
+{
+    size_t count = pool->worker_count;
+
+    if (count == 0) {
+        return false;
+    }
+
+    // Visit every other worker once, starting from a random victim
+    size_t start = thread_pool_random(count);
+
+    for (size_t i = 0; i < count; i++) {
+        thread_pool_worker_t *victim = &pool->workers[(start + i) % count];
+
+        if (victim != worker && ws_deque_steal(victim->deque, task)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool thread_pool_find(thread_pool_t *pool, thread_pool_worker_t *worker, thread_pool_task_t *task)
+{
+    if (worker != NULL && ws_deque_pop(worker->deque, task)) {
+        return true;
+    }
+
+    if (mpmc_queue_try_dequeue(pool->injector, task)) {
+        return true;
+    }
+
+    return thread_pool_steal(pool, worker, task);
+}
+
+static void thread_pool_run(thread_pool_t *pool, thread_pool_task_t *task);
+
+static void thread_pool_push(thread_pool_t *pool, const thread_pool_task_t *task)
+{
+    thread_pool_worker_t *worker = thread_pool_worker(pool);
+
+    if (worker != NULL) {
+        ws_deque_push(worker->deque, task);
+    } else {
+        // Make room in a full injector by running what is queued in it
+        while (!mpmc_queue_try_enqueue(pool->injector, task)) {
+            thread_pool_task_t queued;
+
+            if (mpmc_queue_try_dequeue(pool->injector, &queued)) {
+                thread_pool_run(pool, &queued);
+            }
+        }
+    }
+
+    thread_pool_notify(pool);
+}
+
+/*
+ * Processes [begin, end) of a parallel_for: the upper halves are left for
+ * thieves until the piece is down to the grain, which is then run here.
+ */
+static void thread_pool_run_range(thread_pool_t *pool, thread_pool_range_t *range, size_t begin, size_t end)
+{
+    while (end - begin > range->grain) {
+        size_t middle = begin + (end - begin) / 2;
+        thread_pool_task_t task = {NULL, range, middle, end};
+
+        thread_pool_push(pool, &task);
+        end = middle;
+    }
+
+    range->function(begin, end, range->arg);
+
+    // Last access to the range, which may go out of scope right after
+    atomic_fetch_sub_explicit(&range->remaining, end - begin, memory_order_acq_rel);
+}
+
+static void thread_pool_run(thread_pool_t *pool, thread_pool_task_t *task)
+{
+    if (task->function != NULL) {
+        task->function(task->arg);
+        atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_acq_rel);
+    } else {
+        thread_pool_run_range(pool, task->arg, task->begin, task->end);
+    }
+}
+
+// Runs tasks until the counter drops to zero
+static void thread_pool_help(thread_pool_t *pool, _Atomic size_t *counter)
+{
+    thread_pool_worker_t *worker = thread_pool_worker(pool);
+    thread_pool_task_t task;
+
+    while (atomic_load_explicit(counter, memory_order_acquire) > 0) {
+        if (thread_pool_find(pool, worker, &task)) {
+            thread_pool_run(pool, &task);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void *thread_pool_worker_main(void *arg)
+{
+    thread_pool_worker_t *worker = arg;
+    thread_pool_t *pool = worker->pool;
+    thread_pool_task_t task;
+
+    thread_pool_current = worker;
+
+    while (!atomic_load_explicit(&pool->stop, memory_order_acquire)) {
+        // Taken before searching, so work submitted during the search prevents parking
+        uint64_t ticket = atomic_load_explicit(&pool->signal, memory_order_seq_cst);
+        bool found = false;
+
+        for (size_t round = 0; round < THREAD_POOL_SEARCH_ROUNDS && !found; round++) {
+            found = thread_pool_find(pool, worker, &task);
+        }
+
+        if (found) {
+            thread_pool_run(pool, &task);
+        } else {
+            thread_pool_park(pool, ticket);
+        }
+    }
+
+    thread_pool_current = NULL;
+
+    return NULL;
+}
+
+thread_pool_t *thread_pool_create(size_t thread_count)
+{
+    if (thread_count == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (size_t)online : 1;
+    }
+
+    thread_pool_t *pool = SAFE_CALLOC(1, sizeof(thread_pool_t));
+
+    pool->workers = SAFE_CALLOC(thread_count, sizeof(thread_pool_worker_t));
+    pool->injector = mpmc_queue_create(sizeof(thread_pool_task_t), THREAD_POOL_INJECTOR_CAPACITY, NULL, NULL);
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    atomic_init(&pool->signal, 0);
+    atomic_init(&pool->sleepers, 0);
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->stop, false);
+
+    // Every deque exists before any worker may try to steal from it
+    for (size_t i = 0; i < thread_count; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].deque = ws_deque_create(sizeof(thread_pool_task_t), THREAD_POOL_DEQUE_CAPACITY, 0.75f, NULL, NULL);
+    }
+
+    pool->worker_count = thread_count;
+
+    for (size_t i = 0; i < thread_count; i++) {
+        if (pthread_create(&pool->workers[i].thread, NULL, thread_pool_worker_main, &pool->workers[i]) != 0) {
+            fprintf(stderr, "Thread pool: failed to start worker %zu\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return pool;
+}
+
+void thread_pool_destroy(thread_pool_t **pool)
+{
+    if (*pool == NULL) {
+        return;
+    }
+
+    thread_pool_wait(*pool);
+
+    pthread_mutex_lock(&(*pool)->lock);
+    atomic_store_explicit(&(*pool)->stop, true, memory_order_release);
+    pthread_cond_broadcast(&(*pool)->wake);
+    pthread_mutex_unlock(&(*pool)->lock);
+
+    for (size_t i = 0; i < (*pool)->worker_count; i++) {
+        pthread_join((*pool)->workers[i].thread, NULL);
+        ws_deque_destroy(&(*pool)->workers[i].deque, CF_NONE);
+    }
+
+    mpmc_queue_destroy(&(*pool)->injector, CF_NONE);
+
+    pthread_cond_destroy(&(*pool)->wake);
+    pthread_mutex_destroy(&(*pool)->lock);
+
+    free((*pool)->workers);
+    free(*pool);
+
+    *pool = NULL;
+}
+
+void thread_pool_submit(thread_pool_t *pool, task_function_t function, void *arg)
+{
+    if (pool == NULL || function == NULL) {
+        return;
+    }
+
+    thread_pool_task_t task = {function, arg, 0, 0};
+
+    atomic_fetch_add_explicit(&pool->pending, 1, memory_order_relaxed);
+    thread_pool_push(pool, &task);
+}
+
+void thread_pool_wait(thread_pool_t *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    thread_pool_help(pool, &pool->pending);
+}
+
+void parallel_for(thread_pool_t *pool, size_t begin, size_t end, size_t grain, range_function_t function, void *arg)
+{
+    if (function == NULL || begin >= end) {
+        return;
+    }
+
+    if (pool == NULL) {
+        function(begin, end, arg);
+        return;
+    }
+
+    if (grain == 0) {
+        // A few pieces per worker, so thieves can even out uneven pieces
+        size_t pieces = (pool->worker_count + 1) * 8;
+        grain = (end - begin + pieces - 1) / pieces;
+    }
+
+    thread_pool_range_t range = {function, arg, grain, end - begin};
+
+    thread_pool_run_range(pool, &range, begin, end);
+    thread_pool_help(pool, &range.remaining);
+}
+
+size_t thread_pool_size(thread_pool_t *pool)
+{
+    return pool != NULL ? pool->worker_count : 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file thread_pool.h
+ * @author Secareanu Filip
+ * @brief   This is the header file for the work-stealing thread pool.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines a task scheduler with a fixed set of worker threads. Each
+ * worker owns a ws_deque_t: tasks it spawns go to the bottom of its own deque
+ * and it runs them from there, newest first, which keeps the data they touch
+ * warm in its cache. A worker whose deque runs dry steals the oldest task of
+ * a randomly chosen victim, which tends to be the largest piece of work the
+ * victim has left. Tasks submitted by threads outside the pool go through a
+ * shared mpmc_queue_t that every worker polls.
+ *
+ * A worker that finds no work anywhere parks on a condition variable instead
+ * of spinning, and submitting a task only takes the lock when some worker is
+ * parked, so a busy pool never touches it.
+ *
+ * parallel_for runs a function over an index range, split in halves on demand
+ * until the pieces are no larger than a grain: a worker keeps one half and
+ * leaves the other on its deque for thieves, so the range spreads over the
+ * pool without one task per index. It is meant for bulk work over the
+ * library's buffers, such as the elements of a stack_t or queue_t or the
+ * segments of a dll_list_t.
+ *
+ * A thread waiting for tasks to finish (thread_pool_wait, parallel_for) runs
+ * tasks itself in the meantime, so nested parallelism cannot deadlock the
+ * pool. Creation, destruction and thread_pool_wait must not be called from
+ * inside a task; everything else may be called from any thread.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "../common/generic/memory_utils.h"
+#include "../common/generic/container_utils.h"
+#include "../deque/ws_deque.h"
+#include "../queue/mpmc_queue.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+/**
+ * @brief Initial capacity of every worker's deque.
+ */
+#define THREAD_POOL_DEQUE_CAPACITY 64
+
+/**
+ * @brief Capacity of the queue receiving tasks from threads outside the pool.
+ */
+#define THREAD_POOL_INJECTOR_CAPACITY 1024
+
+/**
+ * @brief Number of times an idle worker looks for work before it parks.
+ */
+#define THREAD_POOL_SEARCH_ROUNDS 4
+
+/**
+ * @brief Function run by a task.
+ */
+typedef void (*task_function_t)(void *arg);
+
+/**
+ * @brief Function run by parallel_for over the half-open index range [begin, end).
+ */
+typedef void (*range_function_t)(size_t begin, size_t end, void *arg);
+
+/**
+ * @brief A unit of work, copied in and out of the deques and the injector.
+ */
+typedef struct thread_pool_task {
+    task_function_t function;       ///< Function to run, NULL for a piece of a parallel_for.
+    void *arg;                      ///< Argument of function, or the parallel_for the piece belongs to.
+    size_t begin;                   ///< First index of a parallel_for piece.
+    size_t end;                     ///< One past the last index of a parallel_for piece.
+} thread_pool_task_t;
+
+typedef struct thread_pool thread_pool_t;
+
+/**
+ * @brief A worker thread and its deque, padded to keep workers off each other's cache lines.
+ */
+typedef struct thread_pool_worker {
+    thread_pool_t *pool;            ///< Pool the worker belongs to.
+    ws_deque_t *deque;              ///< Tasks spawned by the worker; only it pushes and pops.
+    pthread_t thread;               ///< The worker thread.
+    unsigned char pad[CACHE_LINE_SIZE];     ///< Keeps neighbouring workers apart.
+} thread_pool_worker_t;
+
+/**
+ * @brief The primary structure representing a thread pool.
+ */
+struct thread_pool {
+    thread_pool_worker_t *workers;  ///< The workers.
+    size_t worker_count;            ///< Number of workers.
+    mpmc_queue_t *injector;         ///< Tasks submitted from outside the pool.
+
+    pthread_mutex_t lock;           ///< Protects parking.
+    pthread_cond_t wake;            ///< Signalled when work arrives for parked workers.
+
+    unsigned char pad_shared[CACHE_LINE_SIZE];  ///< Separates the read-mostly fields from the counters.
+
+    _Atomic uint64_t signal;        ///< Bumped on every submission, so a worker about to park notices new work.
+    _Atomic size_t sleepers;        ///< Number of workers parked or about to park.
+    _Atomic size_t pending;         ///< Number of submitted tasks that have not finished.
+    _Atomic bool stop;              ///< Tells the workers to exit.
+};
+
+/**
+ * @brief Creates a thread pool and starts its workers.
+ *
+ * @param thread_count  Number of worker threads, 0 for one per online processor.
+ * @return A pointer to the new pool.
+ */
+thread_pool_t *thread_pool_create(size_t thread_count);
+
+/**
+ * @brief Runs every pending task, stops the workers and frees the pool.
+ *
+ * Must not be called from inside one of the pool's tasks.
+ *
+ * @param pool  Pointer to the pool's pointer. Will set *pool to NULL after deallocation.
+ */
+void thread_pool_destroy(thread_pool_t **pool);
+
+/**
+ * @brief Schedules function(arg) to run on the pool.
+ *
+ * Called from a worker, the task goes to its own deque; otherwise it goes to
+ * the injector, and if that is full the caller runs queued tasks until there
+ * is room.
+ *
+ * @param pool      A pointer to the pool.
+ * @param function  Function to run.
+ * @param arg       Argument passed to function.
+ */
+void thread_pool_submit(thread_pool_t *pool, task_function_t function, void *arg);
+
+/**
+ * @brief Returns once every task submitted so far, and every task they submitted, has finished.
+ *
+ * The caller runs tasks while it waits. Must not be called from inside a task,
+ * which would wait for itself.
+ *
+ * @param pool  A pointer to the pool.
+ */
+void thread_pool_wait(thread_pool_t *pool);
+
+/**
+ * @brief Runs function over [begin, end) on the pool and returns once the whole range is done.
+ *
+ * The range is split in halves until the pieces hold at most grain indices,
+ * and each piece is passed to function as its own sub-range. Pieces run in no
+ * particular order and concurrently, so function must only touch the indices
+ * it is given. The caller runs pieces while it waits.
+ *
+ * @param pool      A pointer to the pool, NULL to run the whole range on the calling thread.
+ * @param begin     First index.
+ * @param end       One past the last index.
+ * @param grain     Largest number of indices in a piece, 0 to pick one from the pool size.
+ * @param function  Function run over every piece.
+ * @param arg       Argument passed to function.
+ */
+void parallel_for(thread_pool_t *pool, size_t begin, size_t end, size_t grain, range_function_t function, void *arg);
+
+/**
+ * @brief Returns the number of worker threads.
+ *
+ * @param pool  A pointer to the pool.
+ * @return The number of workers, 0 if pool is NULL.
+ */
+size_t thread_pool_size(thread_pool_t *pool);
+
+#endif // THREAD_POOL_H
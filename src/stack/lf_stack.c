@@ -0,0 +1,415 @@
+/**
+ * @file lf_stack.c
+ * @author Secareanu Filip
+ * @brief   This is the source file for the lock-free stack implementation.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "lf_stack.h"
+
+#define LF_STACK_NIL UINT32_MAX
+
+typedef struct lf_stack_node lf_stack_node_t;
+
+struct lf_stack_node {
+    _Atomic uint32_t next;
+    _Alignas(max_align_t) unsigned char data[];
+};
+
+/*
+ * Heads and elimination slots pack a 32-bit tag above a 32-bit node index.
+ * Every successful update bumps the tag.
+ */
+static uint64_t lf_stack_pack(uint32_t index, uint32_t tag)
+{
+    return ((uint64_t)tag << 32) | index;
+}
+
+static uint32_t lf_stack_index(uint64_t value)
+{
+    return (uint32_t)value;
+}
+
+static uint32_t lf_stack_tag(uint64_t value)
+{
+    return (uint32_t)(value >> 32);
+}
+
+static lf_stack_node_t *lf_stack_node(lf_stack_t *stack, uint32_t index)
+{
+    // Chunk k starts at index chunk_nodes * (2^k - 1)
+    size_t k = 63 - (size_t)__builtin_clzll((unsigned long long)(index / stack->chunk_nodes + 1));
+    size_t offset = index - stack->chunk_nodes * (((size_t)1 << k) - 1);
+    unsigned char *chunk = atomic_load_explicit(&stack->chunks[k], memory_order_relaxed);
+
+    return (lf_stack_node_t *)(chunk + offset * stack->node_size);
+}
+
+static void lf_stack_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static size_t lf_stack_random_slot(void)
+{
+    static _Thread_local uint32_t seed;
+
+    if (seed == 0) {
+        seed = (uint32_t)(uintptr_t)&seed | 1;
+    }
+
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return seed % LF_STACK_ELIMINATION_SIZE;
+}
+
+/*
+ * Pushes the chain first..last (already linked through next) onto a tagged
+ * list head.
+ */
+static void lf_stack_list_push(lf_stack_t *stack, _Atomic uint64_t *list, uint32_t first, uint32_t last)
+{
+    lf_stack_node_t *last_node = lf_stack_node(stack, last);
+    uint64_t head = atomic_load_explicit(list, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&last_node->next, lf_stack_index(head), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(list, &head, lf_stack_pack(first, lf_stack_tag(head) + 1), memory_order_release, memory_order_relaxed));
+}
+
+static uint32_t lf_stack_list_pop(lf_stack_t *stack, _Atomic uint64_t *list)
+{
+    uint64_t head = atomic_load_explicit(list, memory_order_acquire);
+
+    while (lf_stack_index(head) != LF_STACK_NIL) {
+        // The node may be popped and reused meanwhile, but its memory stays
+        // valid and the tag makes the CAS below fail in that case
+        uint32_t next = atomic_load_explicit(&lf_stack_node(stack, lf_stack_index(head))->next, memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(list, &head, lf_stack_pack(next, lf_stack_tag(head) + 1), memory_order_acquire, memory_order_acquire)) {
+            return lf_stack_index(head);
+        }
+    }
+
+    return LF_STACK_NIL;
+}
+
+/*
+ * Allocates the next pool chunk, keeps its first node for the caller and
+ * hands the others to the free list.
+ */
+static uint32_t lf_stack_grow(lf_stack_t *stack, uint32_t chunk)
+{
+    size_t count = stack->chunk_nodes << chunk;
+    size_t first = stack->chunk_nodes * (((size_t)1 << chunk) - 1);
+
+    if (first + count > LF_STACK_NIL) {
+        return LF_STACK_NIL;
+    }
+
+    unsigned char *memory = ALLOCATOR_ALLOC(&stack->allocator, count * stack->node_size);
+    atomic_store_explicit(&stack->chunks[chunk], memory, memory_order_release);
+
+    if (count > 1) {
+        for (size_t i = first + 1; i + 1 < first + count; i++) {
+            atomic_store_explicit(&lf_stack_node(stack, (uint32_t)i)->next, (uint32_t)(i + 1), memory_order_relaxed);
+        }
+        lf_stack_list_push(stack, &stack->free_head, (uint32_t)(first + 1), (uint32_t)(first + count - 1));
+    }
+
+    return (uint32_t)first;
+}
+
+static uint32_t lf_stack_node_alloc(lf_stack_t *stack)
+{
+    for (;;) {
+        uint32_t index = lf_stack_list_pop(stack, &stack->free_head);
+
+        if (index != LF_STACK_NIL) {
+            return index;
+        }
+
+        uint32_t chunk = atomic_load_explicit(&stack->chunk_count, memory_order_relaxed);
+
+        if (chunk == LF_STACK_MAX_CHUNKS) {
+            return LF_STACK_NIL;
+        }
+
+        // Another thread is still filling the free list from the last chunk
+        if (atomic_load_explicit(&stack->chunk_ready, memory_order_acquire) != chunk) {
+            lf_stack_relax();
+            continue;
+        }
+
+        // Whoever bumps the count allocates that chunk, the others retry the free list
+        if (atomic_compare_exchange_strong_explicit(&stack->chunk_count, &chunk, chunk + 1, memory_order_relaxed, memory_order_relaxed)) {
+            uint32_t index = lf_stack_grow(stack, chunk);
+
+            atomic_store_explicit(&stack->chunk_ready, chunk + 1, memory_order_release);
+
+            return index;
+        }
+    }
+}
+
+static bool lf_stack_eliminate_push(lf_stack_t *stack, uint32_t index)
+{
+    lf_stack_slot_t *slot = &stack->elimination[lf_stack_random_slot()];
+    uint64_t value = atomic_load_explicit(&slot->value, memory_order_relaxed);
+
+    if (lf_stack_index(value) != LF_STACK_NIL) {
+        return false;
+    }
+
+    uint64_t offer = lf_stack_pack(index, lf_stack_tag(value) + 1);
+
+    if (!atomic_compare_exchange_strong_explicit(&slot->value, &value, offer, memory_order_release, memory_order_relaxed)) {
+        return false;
+    }
+
+    for (int i = 0; i < LF_STACK_ELIMINATION_SPINS; i++) {
+        if (atomic_load_explicit(&slot->value, memory_order_relaxed) != offer) {
+            return true;
+        }
+        lf_stack_relax();
+    }
+
+    // Withdraw the offer, unless a pop took it in the meantime
+    return !atomic_compare_exchange_strong_explicit(&slot->value, &offer, lf_stack_pack(LF_STACK_NIL, lf_stack_tag(offer) + 1), memory_order_relaxed, memory_order_relaxed);
+}
+
+static uint32_t lf_stack_eliminate_pop(lf_stack_t *stack)
+{
+    lf_stack_slot_t *slot = &stack->elimination[lf_stack_random_slot()];
+    uint64_t value = atomic_load_explicit(&slot->value, memory_order_relaxed);
+
+    if (lf_stack_index(value) == LF_STACK_NIL) {
+        return LF_STACK_NIL;
+    }
+
+    if (atomic_compare_exchange_strong_explicit(&slot->value, &value, lf_stack_pack(LF_STACK_NIL, lf_stack_tag(value) + 1), memory_order_acquire, memory_order_relaxed)) {
+        return lf_stack_index(value);
+    }
+
+    return LF_STACK_NIL;
+}
+
+lf_stack_t *lf_stack_create(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function)
+{
+    return lf_stack_create_a(data_size, capacity, free_function, print_function, NULL);
+}
+
+lf_stack_t *lf_stack_create_a(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    lf_stack_t *stack;
+
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    stack = ALLOCATOR_CALLOC(allocator, 1, sizeof(lf_stack_t));
+
+    stack->allocator = *allocator;
+
+    size_t chunk_nodes = 1;
+    while (chunk_nodes < capacity) {
+        chunk_nodes <<= 1;
+    }
+
+    size_t align = _Alignof(lf_stack_node_t);
+
+    stack->chunk_nodes = chunk_nodes;
+    stack->node_size = (sizeof(lf_stack_node_t) + data_size + align - 1) / align * align;
+    stack->data_size = data_size;
+
+    for (size_t i = 0; i < LF_STACK_MAX_CHUNKS; i++) {
+        atomic_init(&stack->chunks[i], NULL);
+    }
+    atomic_init(&stack->chunk_count, 0);
+    atomic_init(&stack->chunk_ready, 0);
+
+    atomic_init(&stack->head, lf_stack_pack(LF_STACK_NIL, 0));
+    atomic_init(&stack->free_head, lf_stack_pack(LF_STACK_NIL, 0));
+
+    for (size_t i = 0; i < LF_STACK_ELIMINATION_SIZE; i++) {
+        atomic_init(&stack->elimination[i].value, lf_stack_pack(LF_STACK_NIL, 0));
+    }
+
+    // Allocate the first chunk up front and put all of it on the free list
+    atomic_store_explicit(&stack->chunk_count, 1, memory_order_relaxed);
+    uint32_t first = lf_stack_grow(stack, 0);
+    lf_stack_list_push(stack, &stack->free_head, first, first);
+    atomic_store_explicit(&stack->chunk_ready, 1, memory_order_relaxed);
+
+    stack->free_function = free_function;
+    stack->print_function = print_function;
+
+    return stack;
+}
+
+void lf_stack_destroy(lf_stack_t **stack, container_flags_t flag)
+{
+    if (*stack == NULL) {
+        return;
+    }
+
+    if (flag == CF_FREE_DATA && (*stack)->free_function != NULL) {
+        uint32_t index = lf_stack_index(atomic_load_explicit(&(*stack)->head, memory_order_acquire));
+
+        while (index != LF_STACK_NIL) {
+            lf_stack_node_t *node = lf_stack_node(*stack, index);
+
+            (*stack)->free_function(node->data);
+            index = atomic_load_explicit(&node->next, memory_order_relaxed);
+        }
+    }
+
+    allocator_t allocator = (*stack)->allocator;
+    uint32_t chunk_count = atomic_load_explicit(&(*stack)->chunk_count, memory_order_acquire);
+
+    for (uint32_t k = 0; k < chunk_count; k++) {
+        unsigned char *chunk = atomic_load_explicit(&(*stack)->chunks[k], memory_order_relaxed);
+        allocator_free(&allocator, chunk, ((*stack)->chunk_nodes << k) * (*stack)->node_size);
+    }
+
+    allocator_free(&allocator, *stack, sizeof(lf_stack_t));
+
+    *stack = NULL;
+}
+
+bool lf_stack_push(lf_stack_t *stack, const void *data)
+{
+    if (stack == NULL || data == NULL) {
+        return false;
+    }
+
+    uint32_t index = lf_stack_node_alloc(stack);
+
+    if (index == LF_STACK_NIL) {
+        return false;
+    }
+
+    // lf_stack_peek may still be reading the node from its previous use
+    lf_stack_node_t *node = lf_stack_node(stack, index);
+    atomic_store_bytes(node->data, data, stack->data_size);
+
+    uint64_t head = atomic_load_explicit(&stack->head, memory_order_relaxed);
+
+    for (;;) {
+        atomic_store_explicit(&node->next, lf_stack_index(head), memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(&stack->head, &head, lf_stack_pack(index, lf_stack_tag(head) + 1), memory_order_release, memory_order_relaxed)) {
+            return true;
+        }
+
+        // Contended: try to hand the node straight to a pop
+        if (lf_stack_eliminate_push(stack, index)) {
+            return true;
+        }
+
+        head = atomic_load_explicit(&stack->head, memory_order_relaxed);
+    }
+}
+
+bool lf_stack_pop(lf_stack_t *stack, void *data)
+{
+    if (stack == NULL || data == NULL) {
+        return false;
+    }
+
+    uint32_t index;
+    uint64_t head = atomic_load_explicit(&stack->head, memory_order_acquire);
+
+    for (;;) {
+        index = lf_stack_index(head);
+
+        if (index == LF_STACK_NIL) {
+            return false;
+        }
+
+        uint32_t next = atomic_load_explicit(&lf_stack_node(stack, index)->next, memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(&stack->head, &head, lf_stack_pack(next, lf_stack_tag(head) + 1), memory_order_acquire, memory_order_acquire)) {
+            break;
+        }
+
+        // Contended: try to take a node straight from a push
+        index = lf_stack_eliminate_pop(stack);
+        if (index != LF_STACK_NIL) {
+            break;
+        }
+
+        head = atomic_load_explicit(&stack->head, memory_order_acquire);
+    }
+
+    memcpy(data, lf_stack_node(stack, index)->data, stack->data_size);
+
+    lf_stack_list_push(stack, &stack->free_head, index, index);
+
+    return true;
+}
+
+bool lf_stack_peek(lf_stack_t *stack, void *data)
+{
+    if (stack == NULL || data == NULL) {
+        return false;
+    }
+
+    uint64_t head = atomic_load_explicit(&stack->head, memory_order_acquire);
+
+    for (;;) {
+        if (lf_stack_index(head) == LF_STACK_NIL) {
+            return false;
+        }
+
+        atomic_load_bytes(data, lf_stack_node(stack, lf_stack_index(head))->data, stack->data_size);
+
+        // Seqlock-style check: the copy may overlap a push that reuses the
+        // node, but then the head (tag included) has changed and the copy is
+        // thrown away. Both sides copy with atomic accesses, so the overlap
+        // is a torn copy rather than a data race. The reload is an acquire
+        // too, since a retry reads the node it names
+        atomic_thread_fence(memory_order_acquire);
+
+        uint64_t again = atomic_load_explicit(&stack->head, memory_order_acquire);
+
+        if (again == head) {
+            return true;
+        }
+
+        head = again;
+    }
+}
+
+bool lf_stack_is_empty(lf_stack_t *stack)
+{
+    if (stack == NULL) {
+        return true;
+    }
+
+    return lf_stack_index(atomic_load_explicit(&stack->head, memory_order_acquire)) == LF_STACK_NIL;
+}
+
+void lf_stack_print(lf_stack_t *stack)
+{
+    if (stack == NULL || stack->print_function == NULL) {
+        return;
+    }
+
+    uint32_t index = lf_stack_index(atomic_load_explicit(&stack->head, memory_order_acquire));
+
+    while (index != LF_STACK_NIL) {
+        lf_stack_node_t *node = lf_stack_node(stack, index);
+
+        stack->print_function(node->data);
+        index = atomic_load_explicit(&node->next, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,178 @@
+/**
+ * @file lf_stack.h
+ * @author Secareanu Filip
+ * @brief   This is the header file for the lock-free stack implementation.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines a generic stack that any number of threads can push to and
+ * pop from at the same time without locks (a Treiber stack). Elements follow
+ * the stack_t model: the client provides their size and optional free and
+ * print functions, and the stack copies them in and out of its nodes.
+ *
+ * Nodes come from a pool owned by the stack and are named by 32-bit indices.
+ * The head packs the index of the top node with a 32-bit tag that changes on
+ * every update, so a compare-and-swap cannot succeed on a head that was popped
+ * and pushed back in between (the ABA problem). Popped nodes go back to the
+ * pool's own lock-free free list, and the pool memory is only released when
+ * the stack is destroyed, so a thread that still reads a node another thread
+ * just popped never touches freed memory.
+ *
+ * When a compare-and-swap on the head fails because of contention, the thread
+ * tries the elimination array instead: a push offers its node in a random
+ * slot for a short while, and a pop that finds an offer takes it, so the pair
+ * completes without touching the head at all.
+ *
+ * Since many threads use the stack at once, operations report their outcome
+ * through their return value instead of a shared error field, and elements
+ * are copied out into caller buffers. The allocator must be thread-safe, as
+ * the pool grows from whichever thread finds it empty. Creation, destruction
+ * and printing are not thread-safe.
+ */
+
+#ifndef LF_STACK_H
+#define LF_STACK_H
+
+#include "../common/error/error.h"
+#include "../common/generic/memory_utils.h"
+#include "../common/generic/container_utils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Maximum number of pool chunks, each twice as large as the previous one.
+ */
+#define LF_STACK_MAX_CHUNKS 32
+
+/**
+ * @brief Number of slots in the elimination array.
+ */
+#define LF_STACK_ELIMINATION_SIZE 8
+
+/**
+ * @brief Number of times a push checks its elimination offer before withdrawing it.
+ */
+#define LF_STACK_ELIMINATION_SPINS 64
+
+/**
+ * @brief An elimination slot, padded to a cache line of its own.
+ */
+typedef struct lf_stack_slot lf_stack_slot_t;
+
+struct lf_stack_slot {
+    _Atomic uint64_t value;                                     ///< Tag and offered node index, or tag and no index.
+    unsigned char pad[CACHE_LINE_SIZE - sizeof(uint64_t)];      ///< Keeps neighbouring slots apart.
+};
+
+/**
+ * @brief The primary structure representing a lock-free stack.
+ */
+typedef struct lf_stack lf_stack_t;
+
+struct lf_stack {
+    _Atomic(unsigned char *) chunks[LF_STACK_MAX_CHUNKS];   ///< Pool chunks, chunk k holds chunk_nodes << k nodes.
+    _Atomic uint32_t chunk_count;       ///< Number of chunks claimed so far.
+    _Atomic uint32_t chunk_ready;       ///< Number of chunks whose nodes are on the free list.
+    size_t chunk_nodes;                 ///< Number of nodes in the first chunk, a power of two.
+    size_t node_size;                   ///< Size (in bytes) of a node.
+    size_t data_size;                   ///< Size (in bytes) of the type of data this stack holds.
+    free_function_t free_function;      ///< Optional custom function for data deallocation.
+    print_function_t print_function;    ///< Optional custom function for displaying stack data.
+    allocator_t allocator;              ///< Allocator used for the stack and its pool.
+
+    unsigned char pad_shared[CACHE_LINE_SIZE];  ///< Separates the read-mostly fields from the head.
+
+    _Atomic uint64_t head;              ///< Tag and index of the top node.
+
+    unsigned char pad_head[CACHE_LINE_SIZE];    ///< Separates the head from the free list.
+
+    _Atomic uint64_t free_head;         ///< Tag and index of the first free node of the pool.
+
+    unsigned char pad_free[CACHE_LINE_SIZE];    ///< Separates the free list from the elimination array.
+
+    lf_stack_slot_t elimination[LF_STACK_ELIMINATION_SIZE]; ///< Slots where pushes and pops meet under contention.
+};
+
+/**
+ * @brief Creates a new lock-free stack instance.
+ *
+ * @param data_size        Size in bytes of the type of data the stack will hold.
+ * @param capacity         Number of nodes allocated up front, rounded up to a power of two.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying stack data.
+ * @return A pointer to the initialized stack.
+ */
+lf_stack_t *lf_stack_create(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Creates a new lock-free stack instance that allocates through a custom, thread-safe allocator.
+ *
+ * @param data_size        Size in bytes of the type of data the stack will hold.
+ * @param capacity         Number of nodes allocated up front, rounded up to a power of two.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying stack data.
+ * @param allocator        Allocator copied into the stack, NULL for the default allocator.
+ * @return A pointer to the initialized stack.
+ */
+lf_stack_t *lf_stack_create_a(size_t data_size, size_t capacity, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Frees memory occupied by the stack. No thread may use the stack anymore.
+ *
+ * @param stack  Pointer to the stack's pointer. Will set *stack to NULL after deallocation.
+ * @param flag   Determines whether to free the stored data as well.
+ */
+void lf_stack_destroy(lf_stack_t **stack, container_flags_t flag);
+
+/**
+ * @brief Pushes a copy of an item onto the stack.
+ *
+ * @param stack  A pointer to the stack.
+ * @param data   Pointer to the data item to push onto the stack.
+ * @return true on success, false if the pool could not grow.
+ */
+bool lf_stack_push(lf_stack_t *stack, const void *data);
+
+/**
+ * @brief Pops the top item from the stack into a caller buffer.
+ *
+ * @param stack  A pointer to the stack.
+ * @param data   Buffer of at least data_size bytes receiving the item.
+ * @return true on success, false if the stack is empty.
+ */
+bool lf_stack_pop(lf_stack_t *stack, void *data);
+
+/**
+ * @brief Copies, but does not remove, the top item of the stack into a caller buffer.
+ *
+ * The copy is retried until the head did not change while it was taken, so it
+ * is never torn; by the time the call returns the item may already be gone.
+ *
+ * @param stack  A pointer to the stack.
+ * @param data   Buffer of at least data_size bytes receiving the item.
+ * @return true on success, false if the stack is empty.
+ */
+bool lf_stack_peek(lf_stack_t *stack, void *data);
+
+/**
+ * @brief Checks if the stack is empty. Called while other threads are active, this is a snapshot.
+ *
+ * @param stack  A pointer to the stack.
+ * @return true if the stack is empty, false otherwise.
+ */
+bool lf_stack_is_empty(lf_stack_t *stack);
+
+/**
+ * @brief Prints the content of the stack, top to bottom. Not safe while other threads are active.
+ *
+ * @param stack  A pointer to the stack.
+ */
+void lf_stack_print(lf_stack_t *stack);
+
+#endif // LF_STACK_H
@@ -11,29 +11,218 @@
 
 #include "stack.h"
 
+// Inline storage starts after the stack, aligned for any element type
+static size_t stack_inline_offset(void)
+{
+    size_t align = _Alignof(max_align_t);
+
+    return (sizeof(stack_t) + align - 1) / align * align;
+}
+
+static bool stack_on_buffer(stack_t *stack)
+{
+    return stack->buffer != NULL && stack->data == stack->buffer;
+}
+
+static void stack_free_data(stack_t *stack)
+{
+    if (stack->free_function == NULL) {
+        return;
+    }
+
+    while (stack->size > 0) {
+        void *source = stack->data + (stack->top * stack->data_size);
+        stack->free_function(source);
+        stack->size--;
+        stack->top--;
+    }
+}
+
+// Smallest capacity the stack shrinks to on its own
+static size_t stack_floor(stack_t *stack)
+{
+    size_t floor = stack->policy.min_capacity;
+
+    if (floor < stack->buffer_capacity) {
+        floor = stack->buffer_capacity;
+    }
+
+    return floor < stack->reserved ? stack->reserved : floor;
+}
+
+// Shrink limit of the given capacity, and the capacity the stack would shrink to
+static size_t stack_shrink_limit(stack_t *stack, size_t capacity, size_t *shrunk)
+{
+    *shrunk = growth_policy_shrink(&stack->policy, capacity, stack_floor(stack));
+
+    return growth_policy_shrink_below(&stack->policy, capacity, *shrunk);
+}
+
+// Recomputes the size limits after the capacity or the policy changed
+static void stack_update_limits(stack_t *stack)
+{
+    size_t shrunk;
+
+    stack->grow_at = growth_policy_grow_at(&stack->policy, stack->capacity);
+    stack->shrink_below = stack_shrink_limit(stack, stack->capacity, &shrunk);
+}
+
+/*
+ * Grows the array to the capacity stack_push would have reached after count
+ * more pushes. Pushes under the growth limit of a capacity are skipped at
+ * once, so this only steps through the resizes.
+ */
+static void stack_grow_for(stack_t *stack, size_t count)
+{
+    size_t capacity = stack->capacity;
+    size_t size = stack->size;
+    size_t end = stack->size + count;
+
+    while (size < end) {
+        size_t grow_at = growth_policy_grow_at(&stack->policy, capacity);
+
+        if (size >= grow_at) {
+            capacity = growth_policy_grow(&stack->policy, capacity);
+            size++;
+        } else {
+            size = grow_at < end ? grow_at : end;
+        }
+    }
+
+    if (capacity != stack->capacity) {
+        stack_resize(stack, capacity);
+    }
+}
+
+// Shrinks the array as far as single pops down to the current size would have
+static void stack_shrink_for(stack_t *stack)
+{
+    size_t capacity = stack->capacity;
+    size_t shrunk;
+
+    while (stack->size < stack_shrink_limit(stack, capacity, &shrunk)) {
+        capacity = shrunk;
+    }
+
+    if (capacity != stack->capacity) {
+        stack_resize(stack, capacity);
+    }
+}
+
 stack_t *stack_create(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function)
+{
+    return stack_create_a(data_size, capacity, grow_treshold, shrink_treshold, free_function, print_function, NULL);
+}
+
+stack_t *stack_create_a(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
 {
     stack_t *stack;
+
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
     
-    stack = SAFE_CALLOC(1, sizeof(stack_t));
+    stack = ALLOCATOR_CALLOC(allocator, 1, sizeof(stack_t));
+
+    stack_init_buffer_a(stack, NULL, data_size, capacity, grow_treshold, shrink_treshold, free_function, print_function, allocator);
+
+    return stack;
+}
+
+stack_t *stack_create_inline(size_t data_size, size_t inline_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function)
+{
+    return stack_create_inline_a(data_size, inline_capacity, grow_treshold, shrink_treshold, free_function, print_function, NULL);
+}
+
+stack_t *stack_create_inline_a(size_t data_size, size_t inline_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    stack_t *stack;
+
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    stack = ALLOCATOR_CALLOC(allocator, 1, stack_inline_offset() + inline_capacity * data_size);
+
+    stack_init_buffer_a(stack, (unsigned char *)stack + stack_inline_offset(), data_size, inline_capacity, grow_treshold, shrink_treshold, free_function, print_function, allocator);
+
+    stack->buffer_inline = true;
 
-    stack->data = SAFE_CALLOC(capacity, data_size);
+    return stack;
+}
+
+void stack_init_buffer(stack_t *stack, void *buffer, size_t data_size, size_t buffer_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function)
+{
+    stack_init_buffer_a(stack, buffer, data_size, buffer_capacity, grow_treshold, shrink_treshold, free_function, print_function, NULL);
+}
+
+void stack_init_buffer_a(stack_t *stack, void *buffer, size_t data_size, size_t buffer_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    stack->allocator = *allocator;
+
+    if (buffer != NULL) {
+        stack->data = buffer;
+        stack->buffer = buffer;
+        stack->buffer_capacity = buffer_capacity;
+    } else {
+        stack->data = ALLOCATOR_CALLOC(allocator, buffer_capacity, data_size);
+        stack->buffer = NULL;
+        stack->buffer_capacity = 0;
+    }
+    stack->buffer_inline = false;
 
     stack->top = SIZE_MAX;
 
     stack->data_size = data_size;
     stack->size = 0;
-    stack->capacity = capacity;
+    stack->capacity = buffer_capacity;
 
-    stack->grow_treshold = grow_treshold;
-    stack->shrink_treshold = shrink_treshold;
+    stack->policy.grow_treshold = grow_treshold;
+    stack->policy.shrink_treshold = shrink_treshold;
+    stack->policy.growth_factor = GROWTH_FACTOR_2X;
+    stack->policy.min_capacity = 1;
+    stack->reserved = 0;
+
+    stack_update_limits(stack);
 
     stack->error = ERROR_NONE;
 
     stack->free_function = free_function;
     stack->print_function = print_function;
+}
 
-    return stack;
+void stack_deinit(stack_t *stack, container_flags_t flag)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    if (flag == CF_FREE_DATA) {
+        stack_free_data(stack);
+    }
+
+    if (!stack_on_buffer(stack)) {
+        allocator_free(&stack->allocator, stack->data, stack->capacity * stack->data_size);
+    }
+
+    stack->data = stack->buffer;
+    stack->capacity = stack->buffer_capacity;
+    stack->reserved = 0;
+
+    stack_update_limits(stack);
+
+    stack->top = SIZE_MAX;
+    stack->size = 0;
+
+    stack->error = ERROR_NONE;
 }
 
 void stack_destroy(stack_t **stack, container_flags_t flag)
@@ -42,17 +231,21 @@ void stack_destroy(stack_t **stack, container_flags_t flag)
         return;
     }
 
-    if (flag == CF_FREE_DATA && (*stack)->free_function) {
-        while ((*stack)->size > 0) {
-            void *source = (*stack)->data + ((*stack)->top * (*stack)->data_size);
-            (*stack)->free_function(source);
-            (*stack)->size--;
-            (*stack)->top--;
-        }
+    if (flag == CF_FREE_DATA) {
+        stack_free_data(*stack);
+    }
+
+    allocator_t allocator = (*stack)->allocator;
+
+    if (!stack_on_buffer(*stack)) {
+        allocator_free(&allocator, (*stack)->data, (*stack)->capacity * (*stack)->data_size);
     }
 
-    free((*stack)->data);
-    free(*stack);
+    if ((*stack)->buffer_inline) {
+        allocator_free(&allocator, *stack, stack_inline_offset() + (*stack)->buffer_capacity * (*stack)->data_size);
+    } else {
+        allocator_free(&allocator, *stack, sizeof(stack_t));
+    }
 
     *stack = NULL;
 }
@@ -68,15 +261,11 @@ void stack_push(stack_t *stack, void *data)
         return;
     }
 
-    if (((float)stack->size) / (float)(stack->capacity) >= stack->grow_treshold) {
-        stack_resize(stack, stack->capacity * 2);
+    if (stack->size >= stack->grow_at) {
+        stack_resize(stack, growth_policy_grow(&stack->policy, stack->capacity));
     }
 
-    if (stack->size == SIZE_MAX) {
-        stack->top = 0;
-    } else {
-        stack->top++;
-    }
+    stack->top = stack->size;
 
     void *source = stack->data + ((stack->top) * stack->data_size);
     memcpy(source, data, stack->data_size);
@@ -97,8 +286,12 @@ void *stack_pop(stack_t *stack)
         return NULL;
     }
 
-    if (((float)stack->size) / (float)(stack->capacity) <= stack->shrink_treshold) {
-        stack_resize(stack, stack->capacity / 2);
+    /*
+     * Shrink while the item still counts, so it is moved along with the rest.
+     * The shrink limit keeps it inside the smaller array.
+     */
+    if (stack->size - 1 < stack->shrink_below) {
+        stack_resize(stack, growth_policy_shrink(&stack->policy, stack->capacity, stack_floor(stack)));
     }
 
     void *data;
@@ -134,6 +327,201 @@ void *stack_peek(stack_t *stack)
     return data;
 }
 
+bool stack_pop_into(stack_t *stack, void *data)
+{
+    if (stack == NULL) {
+        return false;
+    }
+
+    if (data == NULL) {
+        stack->error = ERROR_INVALID_DATA;
+        return false;
+    }
+
+    if (stack->size == 0) {
+        stack->error = ERROR_EMPTY;
+        return false;
+    }
+
+    // Copy first: shrinking may release the slot the item lives in
+    void *source = stack->data + ((stack->top) * stack->data_size);
+    memcpy(data, source, stack->data_size);
+
+    stack->size--;
+    stack->top--;
+
+    if (stack->size < stack->shrink_below) {
+        stack_resize(stack, growth_policy_shrink(&stack->policy, stack->capacity, stack_floor(stack)));
+    }
+
+    stack->error = ERROR_NONE;
+
+    return true;
+}
+
+const void *stack_peek_ref(stack_t *stack)
+{
+    if (stack == NULL) {
+        return NULL;
+    }
+
+    if (stack->size == 0) {
+        stack->error = ERROR_EMPTY;
+        return NULL;
+    }
+
+    stack->error = ERROR_NONE;
+
+    return stack->data + ((stack->top) * stack->data_size);
+}
+
+bool stack_peek_into(stack_t *stack, void *data)
+{
+    if (stack == NULL) {
+        return false;
+    }
+
+    if (data == NULL) {
+        stack->error = ERROR_INVALID_DATA;
+        return false;
+    }
+
+    if (stack->size == 0) {
+        stack->error = ERROR_EMPTY;
+        return false;
+    }
+
+    void *source = stack->data + ((stack->top) * stack->data_size);
+    memcpy(data, source, stack->data_size);
+
+    stack->error = ERROR_NONE;
+
+    return true;
+}
+
+void stack_push_n(stack_t *stack, const void *array, size_t count)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    if (array == NULL) {
+        stack->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    if (count == 0) {
+        stack->error = ERROR_NONE;
+        return;
+    }
+
+    stack_grow_for(stack, count);
+
+    memcpy(stack->data + (stack->size * stack->data_size), array, count * stack->data_size);
+
+    stack->size += count;
+    stack->top = stack->size - 1;
+
+    stack->error = ERROR_NONE;
+}
+
+size_t stack_pop_n(stack_t *stack, void *array, size_t count)
+{
+    if (stack == NULL) {
+        return 0;
+    }
+
+    if (array == NULL) {
+        stack->error = ERROR_INVALID_DATA;
+        return 0;
+    }
+
+    if (count > stack->size) {
+        count = stack->size;
+    }
+
+    memcpy(array, stack->data + ((stack->size - count) * stack->data_size), count * stack->data_size);
+
+    // An empty stack wraps top back to SIZE_MAX
+    stack->size -= count;
+    stack->top = stack->size - 1;
+
+    stack_shrink_for(stack);
+
+    stack->error = ERROR_NONE;
+
+    return count;
+}
+
+void stack_set_growth_policy(stack_t *stack, const growth_policy_t *policy)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    if (policy == NULL) {
+        stack->error = ERROR_INVALID_DATA;
+        return;
+    }
+
+    stack->policy = *policy;
+
+    if (stack->capacity < stack->policy.min_capacity) {
+        stack_resize(stack, stack->policy.min_capacity);
+    } else {
+        stack_update_limits(stack);
+    }
+
+    stack->error = ERROR_NONE;
+}
+
+void stack_reserve(stack_t *stack, size_t count)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    size_t capacity = count;
+
+    // Start from the capacity whose growth limit is about count, then step up to it
+    if (stack->policy.grow_treshold > 0.0f && stack->policy.grow_treshold < 1.0f) {
+        capacity = (size_t)((double)count / (double)stack->policy.grow_treshold);
+
+        while (growth_policy_grow_at(&stack->policy, capacity) < count) {
+            capacity++;
+        }
+    }
+
+    stack->reserved = capacity;
+
+    if (capacity > stack->capacity) {
+        stack_resize(stack, capacity);
+    } else {
+        stack_update_limits(stack);
+    }
+
+    stack->error = ERROR_NONE;
+}
+
+void stack_shrink_to_fit(stack_t *stack)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    size_t capacity = stack->size > stack->policy.min_capacity ? stack->size : stack->policy.min_capacity;
+
+    stack->reserved = 0;
+
+    if (capacity < stack->capacity) {
+        stack_resize(stack, capacity);
+    } else {
+        stack_update_limits(stack);
+    }
+
+    stack->error = ERROR_NONE;
+}
+
 void stack_clear(stack_t *stack, container_flags_t flag)
 {
     if (stack == NULL) {
@@ -223,9 +611,33 @@ void stack_resize(stack_t *stack, size_t new_capacity)
         return;
     }
 
-    stack->data = SAFE_REALLOC(stack->data, new_capacity * stack->data_size);
+    size_t kept = stack->size < new_capacity ? stack->size : new_capacity;
+
+    // Any capacity the buffer can hold is served from it
+    if (stack->buffer != NULL && new_capacity <= stack->buffer_capacity) {
+        if (!stack_on_buffer(stack)) {
+            memcpy(stack->buffer, stack->data, kept * stack->data_size);
+            allocator_free(&stack->allocator, stack->data, stack->capacity * stack->data_size);
+            stack->data = stack->buffer;
+        }
+
+        stack->capacity = stack->buffer_capacity;
+        stack_update_limits(stack);
+        return;
+    }
+
+    if (stack_on_buffer(stack)) {
+        // Spill the buffer to the heap
+        void *data = ALLOCATOR_ALLOC(&stack->allocator, new_capacity * stack->data_size);
+
+        memcpy(data, stack->buffer, kept * stack->data_size);
+        stack->data = data;
+    } else {
+        stack->data = ALLOCATOR_REALLOC(&stack->allocator, stack->data, stack->capacity * stack->data_size, new_capacity * stack->data_size);
+    }
 
     stack->capacity = new_capacity;
+    stack_update_limits(stack);
 }
 
 void stack_print(stack_t *stack)
@@ -27,6 +27,18 @@
  * of the last occurred error using the `container_error_t` type. This allows
  * for robust error checking and handling by client code.
  *
+ * Short-lived stacks can avoid the heap altogether: a stack can start on a
+ * fixed buffer, either allocated along with the stack (stack_create_inline)
+ * or provided by the caller together with the stack_t itself
+ * (stack_init_buffer). The elements only spill to a heap array once they
+ * outgrow the buffer, and move back into it when the stack shrinks enough.
+ *
+ * How the array grows and shrinks is described by a growth_policy_t. The
+ * stack turns it into integer size limits whenever its capacity changes, so
+ * push and pop compare integers instead of dividing floats, and the shrink
+ * limit leaves a band under the growth limit so a stack oscillating around
+ * one size does not reallocate on every operation.
+ *
  * This stack implementation is part of a larger container library, which
  * includes various utilities for generic programming and error management,
  * ensuring consistency and ease of use across different data structures.
@@ -43,6 +55,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <assert.h>
 
 /**
  * @brief The primary structure representing a generic stack.
@@ -59,11 +72,17 @@ struct stack {
     size_t data_size;                   ///< Size (in bytes) of the type of data this stack holds.
     size_t size;                        ///< Current number of elements in the stack.
     size_t capacity;                    ///< Maximum number of elements the stack can currently hold without resizing.
-    float grow_treshold;                ///< Capacity threshold for triggering stack growth.
-    float shrink_treshold;              ///< Capacity threshold for triggering stack reduction.
+    growth_policy_t policy;             ///< How the stack grows and shrinks with its load.
+    size_t grow_at;                     ///< A push onto a stack of this size grows it first.
+    size_t shrink_below;                ///< A pop leaving fewer elements than this shrinks the stack, 0 for never.
+    size_t reserved;                    ///< Capacity set by stack_reserve that shrinking keeps, 0 if none.
     container_error_t error;            ///< Holds any error status related to the latest stack operation.
     free_function_t free_function;      ///< Optional custom function for data deallocation.
     print_function_t print_function;    ///< Optional custom function for displaying stack data.
+    allocator_t allocator;              ///< Allocator used for the stack and its dynamic array.
+    void *buffer;                       ///< Storage not owned by the heap (inline or caller-provided), NULL if none.
+    size_t buffer_capacity;             ///< Number of elements buffer holds.
+    bool buffer_inline;                 ///< Whether buffer was allocated together with the stack itself.
 };
 
 /**
@@ -79,6 +98,104 @@ struct stack {
  */
 stack_t *stack_create(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function);
 
+/**
+ * @brief Creates a new generic stack instance that allocates through a custom allocator.
+ *
+ * @param data_size        Size in bytes of the type of data the stack will hold.
+ * @param capacity         Initial capacity for the stack.
+ * @param grow_treshold    Percentage (0-1) to determine when the stack needs to expand.
+ * @param shrink_treshold  Percentage (0-1) to determine when the stack needs to shrink.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying stack data.
+ * @param allocator        Allocator copied into the stack, NULL for the default allocator.
+ * @return A pointer to the initialized stack.
+ */
+stack_t *stack_create_a(size_t data_size, size_t capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Creates a new stack whose first elements live in storage allocated along with the stack.
+ *
+ * The stack and room for inline_capacity elements take a single allocation.
+ * Pushing past inline_capacity moves the elements to a heap array, and
+ * shrinking back to inline_capacity or less moves them back.
+ *
+ * @param data_size        Size in bytes of the type of data the stack will hold.
+ * @param inline_capacity  Number of elements stored inline.
+ * @param grow_treshold    Percentage (0-1) to determine when the stack needs to expand.
+ * @param shrink_treshold  Percentage (0-1) to determine when the stack needs to shrink.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying stack data.
+ * @return A pointer to the initialized stack.
+ */
+stack_t *stack_create_inline(size_t data_size, size_t inline_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Creates a new stack with inline storage that allocates through a custom allocator.
+ *
+ * @param data_size        Size in bytes of the type of data the stack will hold.
+ * @param inline_capacity  Number of elements stored inline.
+ * @param grow_treshold    Percentage (0-1) to determine when the stack needs to expand.
+ * @param shrink_treshold  Percentage (0-1) to determine when the stack needs to shrink.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying stack data.
+ * @param allocator        Allocator copied into the stack, NULL for the default allocator.
+ * @return A pointer to the initialized stack.
+ */
+stack_t *stack_create_inline_a(size_t data_size, size_t inline_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Initializes a caller-owned stack that starts on a caller-provided buffer.
+ *
+ * Neither the stack nor its elements touch the heap until the buffer
+ * overflows, so a stack_t and an array in automatic storage make a worklist
+ * that costs no allocation at all:
+ *
+ *   stack_t worklist;
+ *   node_t *buffer[64];
+ *   stack_init_buffer(&worklist, buffer, sizeof(node_t *), 64, 0.75f, 0.25f, NULL, NULL);
+ *   ...
+ *   stack_deinit(&worklist, CF_NONE);
+ *
+ * The buffer must outlive the stack. Such a stack is released with
+ * stack_deinit, never stack_destroy.
+ *
+ * @param stack            The stack to initialize.
+ * @param buffer           Storage for buffer_capacity elements, NULL to start on the heap.
+ * @param data_size        Size in bytes of the type of data the stack will hold.
+ * @param buffer_capacity  Number of elements buffer holds.
+ * @param grow_treshold    Percentage (0-1) to determine when the stack needs to expand.
+ * @param shrink_treshold  Percentage (0-1) to determine when the stack needs to shrink.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying stack data.
+ */
+void stack_init_buffer(stack_t *stack, void *buffer, size_t data_size, size_t buffer_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function);
+
+/**
+ * @brief Initializes a caller-owned stack on a caller-provided buffer, spilling through a custom allocator.
+ *
+ * @param stack            The stack to initialize.
+ * @param buffer           Storage for buffer_capacity elements, NULL to start on the heap.
+ * @param data_size        Size in bytes of the type of data the stack will hold.
+ * @param buffer_capacity  Number of elements buffer holds.
+ * @param grow_treshold    Percentage (0-1) to determine when the stack needs to expand.
+ * @param shrink_treshold  Percentage (0-1) to determine when the stack needs to shrink.
+ * @param free_function    Optional custom function for data deallocation.
+ * @param print_function   Optional custom function for displaying stack data.
+ * @param allocator        Allocator copied into the stack, NULL for the default allocator.
+ */
+void stack_init_buffer_a(stack_t *stack, void *buffer, size_t data_size, size_t buffer_capacity, float grow_treshold, float shrink_treshold, free_function_t free_function, print_function_t print_function, const allocator_t *allocator);
+
+/**
+ * @brief Releases the elements and any heap array of a stack set up with stack_init_buffer.
+ *
+ * The stack_t itself is left to the caller. Afterwards the stack is empty and
+ * back on its buffer, ready to be used again.
+ *
+ * @param stack  The stack to release.
+ * @param flag   Determines whether to free the stored data as well.
+ */
+void stack_deinit(stack_t *stack, container_flags_t flag);
+
 /**
  * @brief Frees memory occupied by the stack.
  *
@@ -101,6 +218,8 @@ void stack_push(stack_t *stack, void *data);
  * @brief Pops an item from the stack.
  *
  * Removes the top item from the stack and returns it. It's the caller's responsibility to free the returned data when done.
+ * The pointer refers to the item's slot in the stack's array, which holds the item, even if the pop
+ * shrinks the stack, until the next operation that modifies the stack.
  *
  * @param stack  A pointer to the stack.
  * @return Pointer to the popped data.
@@ -110,11 +229,107 @@ void *stack_pop(stack_t *stack);
 /**
  * @brief Retrieves, but does not remove, the top item from the stack.
  *
+ * The item is returned as a copy allocated with the system allocator, which the caller must free().
+ * stack_peek_ref and stack_peek_into avoid the allocation.
+ *
  * @param stack  A pointer to the stack.
  * @return Pointer to the top data item.
  */
 void *stack_peek(stack_t *stack);
 
+/**
+ * @brief Pops the top item from the stack into a caller buffer.
+ *
+ * Unlike stack_pop, the item is copied out before the stack may shrink, so
+ * nothing refers to the stack's array afterwards.
+ *
+ * @param stack  A pointer to the stack.
+ * @param data   Buffer of at least data_size bytes receiving the item.
+ * @return true on success, false if the stack is empty or data is NULL.
+ */
+bool stack_pop_into(stack_t *stack, void *data);
+
+/**
+ * @brief Returns a pointer to the top item, inside the stack's own array.
+ *
+ * Nothing is allocated or copied. The pointer is borrowed: it stays valid
+ * until the next operation that modifies the stack.
+ *
+ * @param stack  A pointer to the stack.
+ * @return Pointer to the top data item, or NULL if the stack is empty.
+ */
+const void *stack_peek_ref(stack_t *stack);
+
+/**
+ * @brief Copies, but does not remove, the top item into a caller buffer.
+ *
+ * @param stack  A pointer to the stack.
+ * @param data   Buffer of at least data_size bytes receiving the item.
+ * @return true on success, false if the stack is empty or data is NULL.
+ */
+bool stack_peek_into(stack_t *stack, void *data);
+
+/**
+ * @brief Pushes count items from an array onto the stack, array[count - 1] ending on top.
+ *
+ * The capacity is grown once, to what count single pushes would have reached,
+ * and the items are moved with a single copy.
+ *
+ * @param stack  A pointer to the stack.
+ * @param array  Pointer to the items to push.
+ * @param count  Number of items to push.
+ */
+void stack_push_n(stack_t *stack, const void *array, size_t count);
+
+/**
+ * @brief Pops up to count items from the top of the stack into an array.
+ *
+ * The items keep their stack order: array[0] is the deepest item popped and
+ * the former top ends up last, so stack_push_n with the same array restores
+ * the stack. They are moved with a single copy, and the stack shrinks at most
+ * once afterwards.
+ *
+ * @param stack  A pointer to the stack.
+ * @param array  Buffer with room for count items.
+ * @param count  Largest number of items to pop.
+ * @return The number of items popped, less than count if the stack ran out.
+ */
+size_t stack_pop_n(stack_t *stack, void *array, size_t count);
+
+/**
+ * @brief Replaces the growth policy of the stack.
+ *
+ * The stack grows to the policy's minimum capacity right away if it is under
+ * it. A stack created with stack_create grows by 2x with a minimum capacity
+ * of 1.
+ *
+ * @param stack   A pointer to the stack.
+ * @param policy  The new policy.
+ */
+void stack_set_growth_policy(stack_t *stack, const growth_policy_t *policy);
+
+/**
+ * @brief Makes room for count items, so pushing up to count items does not resize the stack.
+ *
+ * The capacity is also kept from then on: popping never shrinks the stack
+ * under it, until stack_shrink_to_fit.
+ *
+ * @param stack  A pointer to the stack.
+ * @param count  Number of items the stack must hold without resizing.
+ */
+void stack_reserve(stack_t *stack, size_t count);
+
+/**
+ * @brief Shrinks the capacity to the number of items held.
+ *
+ * Drops any capacity kept by stack_reserve. The capacity never goes under the
+ * policy's minimum, and a stack with a buffer moves back into it when the
+ * items fit.
+ *
+ * @param stack  A pointer to the stack.
+ */
+void stack_shrink_to_fit(stack_t *stack);
+
 /**
  * @brief Clears the stack of all items without destroying the stack itself.
  *
@@ -162,6 +377,8 @@ void stack_from_array(stack_t *stack, void *array, size_t array_size);
  * @brief Resizes the stack to the given capacity.
  *
  * If the new capacity is smaller than the current size, items will be lost.
+ * A stack with a buffer uses it, at its full capacity, whenever the new
+ * capacity fits in it, and a heap array otherwise.
  *
  * @param stack        A pointer to the stack.
  * @param new_capacity The desired capacity for the stack.
@@ -177,4 +394,76 @@ void stack_resize(stack_t *stack, size_t new_capacity);
  */
 void stack_print(stack_t *stack);
 
+/**
+ * @brief Defines typed, inline stack operations for elements of type T, prefixed with name.
+ *
+ * The generated functions work on ordinary stack_t instances holding
+ * sizeof(T)-byte elements, so typed and void * calls can be mixed on the same
+ * stack. With the element size known at compile time, a push or pop that does
+ * not resize the array is a compare against the stack's size limits and a
+ * plain store or load; the ones that do resize go through the out-of-line
+ * functions. For DEFINE_STACK(int_stack, int):
+ *
+ *   stack_t *int_stack_create(size_t capacity, float grow_treshold, float shrink_treshold);
+ *   void int_stack_push(stack_t *stack, int value);
+ *   bool int_stack_pop(stack_t *stack, int *value);
+ *   bool int_stack_peek(stack_t *stack, int *value);
+ *   int *int_stack_data(stack_t *stack);     (the elements, bottom to top)
+ *
+ * pop and peek return false on an empty stack, like stack_pop_into.
+ */
+#define DEFINE_STACK(name, T)                                                                       \
+static inline stack_t *name##_create(size_t capacity, float grow_treshold, float shrink_treshold)  \
+{                                                                                                   \
+    return stack_create(sizeof(T), capacity, grow_treshold, shrink_treshold, NULL, NULL);           \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_push(stack_t *stack, T value)                                             \
+{                                                                                                   \
+    assert(stack->data_size == sizeof(T));                                                          \
+                                                                                                    \
+    if (stack->size < stack->grow_at) {                                                             \
+        ((T *)stack->data)[stack->size] = value;                                                    \
+        stack->top = stack->size++;                                                                 \
+        stack->error = ERROR_NONE;                                                                  \
+    } else {                                                                                        \
+        stack_push(stack, &value);                                                                  \
+    }                                                                                               \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_pop(stack_t *stack, T *value)                                             \
+{                                                                                                   \
+    assert(stack->data_size == sizeof(T));                                                          \
+                                                                                                    \
+    if (stack->size > stack->shrink_below) {                                                        \
+        *value = ((T *)stack->data)[--stack->size];                                                 \
+        stack->top = stack->size - 1;                                                               \
+        stack->error = ERROR_NONE;                                                                  \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    return stack_pop_into(stack, value);                                                            \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_peek(stack_t *stack, T *value)                                            \
+{                                                                                                   \
+    assert(stack->data_size == sizeof(T));                                                          \
+                                                                                                    \
+    if (stack->size == 0) {                                                                         \
+        stack->error = ERROR_EMPTY;                                                                 \
+        return false;                                                                               \
+    }                                                                                               \
+                                                                                                    \
+    *value = ((T *)stack->data)[stack->size - 1];                                                   \
+    stack->error = ERROR_NONE;                                                                      \
+    return true;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+static inline T *name##_data(stack_t *stack)                                                        \
+{                                                                                                   \
+    assert(stack->data_size == sizeof(T));                                                          \
+                                                                                                    \
+    return (T *)stack->data;                                                                        \
+}
+
 #endif // STACK_H
@@ -0,0 +1,151 @@
+/**
+ * @file t_epoch.c
+ * @author Secareanu Filip
+ * @brief   Stress test of epoch-based memory reclamation.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Writers keep replacing a shared node and retire the node they unlinked,
+ * while readers keep dereferencing whatever node is current inside a critical
+ * section. The free function poisons a node before freeing it, so a node
+ * reclaimed while a reader could still see it shows up as a poisoned read
+ * (and as a race under ThreadSanitizer). At the end every node allocated must
+ * have been freed exactly once, and the values readers saw must add up.
+ *
+ * Build and run with: make stress (built with ThreadSanitizer)
+ */
+
+#include "../../src/common/generic/epoch.h"
+#include <pthread.h>
+#include <stdio.h>
+
+#define T_EPOCH_READERS 3
+#define T_EPOCH_WRITERS 2
+#define T_EPOCH_UPDATES 20000
+#define T_EPOCH_READS 50000
+#define T_EPOCH_POISON UINT64_MAX
+
+typedef struct t_epoch_node {
+    uint64_t value;
+    uint64_t check;
+} t_epoch_node_t;
+
+typedef struct t_epoch_context {
+    epoch_domain_t *domain;
+    _Atomic(t_epoch_node_t *) shared;
+    _Atomic size_t allocated;
+    _Atomic size_t bad_reads;
+} t_epoch_context_t;
+
+static _Atomic size_t t_epoch_freed;
+
+static t_epoch_node_t *t_epoch_node_create(t_epoch_context_t *context, uint64_t value)
+{
+    t_epoch_node_t *node = SAFE_MALLOC(sizeof(t_epoch_node_t));
+
+    node->value = value;
+    node->check = ~value;
+
+    atomic_fetch_add(&context->allocated, 1);
+
+    return node;
+}
+
+static void t_epoch_node_free(void *ptr)
+{
+    t_epoch_node_t *node = ptr;
+
+    node->value = T_EPOCH_POISON;
+    node->check = T_EPOCH_POISON;
+
+    atomic_fetch_add(&t_epoch_freed, 1);
+
+    free(node);
+}
+
+static void *t_epoch_writer(void *arg)
+{
+    t_epoch_context_t *context = arg;
+    epoch_thread_t *thread = epoch_register(context->domain);
+
+    for (uint64_t i = 1; i <= T_EPOCH_UPDATES; i++) {
+        t_epoch_node_t *node = t_epoch_node_create(context, i);
+
+        epoch_enter(thread);
+        t_epoch_node_t *old = atomic_exchange_explicit(&context->shared, node, memory_order_acq_rel);
+        epoch_exit(thread);
+
+        epoch_retire(thread, old, t_epoch_node_free);
+    }
+
+    epoch_unregister(thread);
+
+    return NULL;
+}
+
+static void *t_epoch_reader(void *arg)
+{
+    t_epoch_context_t *context = arg;
+    epoch_thread_t *thread = epoch_register(context->domain);
+    size_t bad_reads = 0;
+
+    for (size_t i = 0; i < T_EPOCH_READS; i++) {
+        epoch_enter(thread);
+
+        t_epoch_node_t *node = atomic_load_explicit(&context->shared, memory_order_acquire);
+
+        if (node->value == T_EPOCH_POISON || node->check != ~node->value) {
+            bad_reads++;
+        }
+
+        epoch_exit(thread);
+    }
+
+    atomic_fetch_add(&context->bad_reads, bad_reads);
+
+    epoch_unregister(thread);
+
+    return NULL;
+}
+
+int main(void)
+{
+    t_epoch_context_t context = {0};
+    pthread_t readers[T_EPOCH_READERS];
+    pthread_t writers[T_EPOCH_WRITERS];
+
+    context.domain = epoch_domain_create();
+    atomic_init(&context.shared, t_epoch_node_create(&context, 0));
+
+    for (size_t i = 0; i < T_EPOCH_READERS; i++) {
+        pthread_create(&readers[i], NULL, t_epoch_reader, &context);
+    }
+    for (size_t i = 0; i < T_EPOCH_WRITERS; i++) {
+        pthread_create(&writers[i], NULL, t_epoch_writer, &context);
+    }
+
+    for (size_t i = 0; i < T_EPOCH_READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+    for (size_t i = 0; i < T_EPOCH_WRITERS; i++) {
+        pthread_join(writers[i], NULL);
+    }
+
+    size_t freed_while_running = atomic_load(&t_epoch_freed);
+
+    // The domain frees whatever is still pending; the current node is ours
+    epoch_domain_destroy(&context.domain);
+    t_epoch_node_free(atomic_load(&context.shared));
+
+    size_t allocated = atomic_load(&context.allocated);
+    size_t freed = atomic_load(&t_epoch_freed);
+    size_t bad_reads = atomic_load(&context.bad_reads);
+    bool passed = bad_reads == 0 && freed == allocated && freed_while_running > 0;
+
+    printf("t_epoch: %s (allocated %zu, freed %zu of which %zu while running, bad reads %zu)\n", passed ? "passed" : "FAILED",
+           allocated, freed, freed_while_running, bad_reads);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
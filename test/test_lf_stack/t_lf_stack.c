@@ -0,0 +1,128 @@
+/**
+ * @file t_lf_stack.c
+ * @author Secareanu Filip
+ * @brief   Stress test of the lock-free stack.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Every thread pushes its own distinct numbers and pops whatever it finds, in
+ * short bursts, so pushes and pops meet on the head and in the elimination
+ * array and the node pool keeps recycling nodes. Each number must be popped
+ * exactly once over the whole run, which the sums on both sides check, while
+ * peeks in between must only ever return numbers that were pushed.
+ *
+ * Build and run with: make stress (built with ThreadSanitizer)
+ */
+
+#include "../../src/stack/lf_stack.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#define T_LF_STACK_THREADS 4
+#define T_LF_STACK_PER_THREAD 50000
+#define T_LF_STACK_BURST 8
+
+typedef struct t_lf_stack_context {
+    lf_stack_t *stack;
+    _Atomic uint64_t pushed_sum;
+    _Atomic uint64_t popped_sum;
+    _Atomic size_t popped;
+    _Atomic size_t bad_values;
+} t_lf_stack_context_t;
+
+typedef struct t_lf_stack_thread {
+    t_lf_stack_context_t *context;
+    size_t id;
+} t_lf_stack_thread_t;
+
+static bool t_lf_stack_valid(uint64_t value)
+{
+    return value >= 1 && value <= (uint64_t)T_LF_STACK_THREADS * T_LF_STACK_PER_THREAD;
+}
+
+static void *t_lf_stack_worker(void *arg)
+{
+    t_lf_stack_thread_t *thread = arg;
+    t_lf_stack_context_t *context = thread->context;
+    uint64_t pushed_sum = 0;
+    uint64_t popped_sum = 0;
+    size_t popped = 0;
+    size_t bad_values = 0;
+    uint64_t value;
+
+    for (size_t i = 0; i < T_LF_STACK_PER_THREAD; i += T_LF_STACK_BURST) {
+        for (size_t j = i; j < i + T_LF_STACK_BURST && j < T_LF_STACK_PER_THREAD; j++) {
+            value = (uint64_t)thread->id * T_LF_STACK_PER_THREAD + j + 1;
+
+            while (!lf_stack_push(context->stack, &value)) {
+                sched_yield();
+            }
+            pushed_sum += value;
+        }
+
+        if (lf_stack_peek(context->stack, &value) && !t_lf_stack_valid(value)) {
+            bad_values++;
+        }
+
+        for (size_t j = 0; j < T_LF_STACK_BURST && lf_stack_pop(context->stack, &value); j++) {
+            if (!t_lf_stack_valid(value)) {
+                bad_values++;
+            }
+            popped_sum += value;
+            popped++;
+        }
+    }
+
+    atomic_fetch_add(&context->pushed_sum, pushed_sum);
+    atomic_fetch_add(&context->popped_sum, popped_sum);
+    atomic_fetch_add(&context->popped, popped);
+    atomic_fetch_add(&context->bad_values, bad_values);
+
+    return NULL;
+}
+
+int main(void)
+{
+    t_lf_stack_context_t context = {0};
+    t_lf_stack_thread_t threads[T_LF_STACK_THREADS];
+    pthread_t workers[T_LF_STACK_THREADS];
+    uint64_t value;
+
+    // A small pool, so it has to grow while the threads run
+    context.stack = lf_stack_create(sizeof(uint64_t), 4, NULL, NULL);
+
+    for (size_t i = 0; i < T_LF_STACK_THREADS; i++) {
+        threads[i].context = &context;
+        threads[i].id = i;
+
+        pthread_create(&workers[i], NULL, t_lf_stack_worker, &threads[i]);
+    }
+
+    for (size_t i = 0; i < T_LF_STACK_THREADS; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    // Whatever the bursts left behind
+    while (lf_stack_pop(context.stack, &value)) {
+        atomic_fetch_add(&context.popped_sum, value);
+        atomic_fetch_add(&context.popped, 1);
+    }
+
+    uint64_t total = (uint64_t)T_LF_STACK_THREADS * T_LF_STACK_PER_THREAD;
+    uint64_t expected_sum = total * (total + 1) / 2;
+    uint64_t pushed_sum = atomic_load(&context.pushed_sum);
+    uint64_t popped_sum = atomic_load(&context.popped_sum);
+    size_t popped = atomic_load(&context.popped);
+    size_t bad_values = atomic_load(&context.bad_values);
+    bool passed = bad_values == 0 && popped == total && pushed_sum == expected_sum && popped_sum == expected_sum;
+
+    printf("t_lf_stack: %s (pushed %llu, popped %llu in %zu pops, bad values %zu)\n", passed ? "passed" : "FAILED",
+           (unsigned long long)pushed_sum, (unsigned long long)popped_sum, popped, bad_values);
+
+    lf_stack_destroy(&context.stack, CF_NONE);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
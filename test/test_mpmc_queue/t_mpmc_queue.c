@@ -0,0 +1,134 @@
+/**
+ * @file t_mpmc_queue.c
+ * @author Secareanu Filip
+ * @brief   Stress test of the MPMC queue.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Several producers enqueue distinct numbers into a small queue while as many
+ * consumers dequeue them. The sum of everything dequeued must equal the sum of
+ * everything enqueued, no number may be seen twice, and every consumer must
+ * see the numbers of any one producer in the order they were enqueued.
+ *
+ * Build and run with: make stress (built with ThreadSanitizer)
+ */
+
+#include "../../src/queue/mpmc_queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#define T_MPMC_THREADS 4
+#define T_MPMC_PER_PRODUCER 50000
+#define T_MPMC_CAPACITY 32
+
+typedef struct t_mpmc_context {
+    mpmc_queue_t *queue;
+    _Atomic size_t consumed;
+    _Atomic uint64_t produced_sum;
+    _Atomic uint64_t consumed_sum;
+    _Atomic size_t out_of_order;
+    unsigned char seen[T_MPMC_THREADS * T_MPMC_PER_PRODUCER];
+} t_mpmc_context_t;
+
+typedef struct t_mpmc_thread {
+    t_mpmc_context_t *context;
+    size_t id;
+} t_mpmc_thread_t;
+
+// Number i of producer id, never 0
+static uint64_t t_mpmc_value(size_t id, size_t i)
+{
+    return (uint64_t)id * T_MPMC_PER_PRODUCER + i + 1;
+}
+
+static void *t_mpmc_producer(void *arg)
+{
+    t_mpmc_thread_t *thread = arg;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < T_MPMC_PER_PRODUCER; i++) {
+        uint64_t value = t_mpmc_value(thread->id, i);
+
+        while (!mpmc_queue_try_enqueue(thread->context->queue, &value)) {
+            sched_yield();
+        }
+        sum += value;
+    }
+
+    atomic_fetch_add(&thread->context->produced_sum, sum);
+
+    return NULL;
+}
+
+static void *t_mpmc_consumer(void *arg)
+{
+    t_mpmc_thread_t *thread = arg;
+    t_mpmc_context_t *context = thread->context;
+    uint64_t last[T_MPMC_THREADS] = {0};
+    uint64_t sum = 0;
+    uint64_t value;
+
+    while (atomic_load(&context->consumed) < T_MPMC_THREADS * T_MPMC_PER_PRODUCER) {
+        if (!mpmc_queue_try_dequeue(context->queue, &value)) {
+            sched_yield();
+            continue;
+        }
+
+        size_t producer = (size_t)((value - 1) / T_MPMC_PER_PRODUCER);
+
+        // Every slot of seen is written by the one consumer that got the number
+        if (value > last[producer] && context->seen[value - 1] == 0) {
+            last[producer] = value;
+        } else {
+            atomic_fetch_add(&context->out_of_order, 1);
+        }
+        context->seen[value - 1] = 1;
+
+        sum += value;
+        atomic_fetch_add(&context->consumed, 1);
+    }
+
+    atomic_fetch_add(&context->consumed_sum, sum);
+
+    return NULL;
+}
+
+int main(void)
+{
+    static t_mpmc_context_t context;
+    t_mpmc_thread_t threads[T_MPMC_THREADS];
+    pthread_t producers[T_MPMC_THREADS];
+    pthread_t consumers[T_MPMC_THREADS];
+
+    context.queue = mpmc_queue_create(sizeof(uint64_t), T_MPMC_CAPACITY, NULL, NULL);
+
+    for (size_t i = 0; i < T_MPMC_THREADS; i++) {
+        threads[i].context = &context;
+        threads[i].id = i;
+
+        pthread_create(&consumers[i], NULL, t_mpmc_consumer, &threads[i]);
+        pthread_create(&producers[i], NULL, t_mpmc_producer, &threads[i]);
+    }
+
+    for (size_t i = 0; i < T_MPMC_THREADS; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+
+    uint64_t total = (uint64_t)T_MPMC_THREADS * T_MPMC_PER_PRODUCER;
+    uint64_t expected_sum = total * (total + 1) / 2;
+    uint64_t produced_sum = atomic_load(&context.produced_sum);
+    uint64_t consumed_sum = atomic_load(&context.consumed_sum);
+    size_t out_of_order = atomic_load(&context.out_of_order);
+    bool passed = out_of_order == 0 && produced_sum == expected_sum && consumed_sum == expected_sum && mpmc_queue_is_empty(context.queue);
+
+    printf("t_mpmc_queue: %s (produced %llu, consumed %llu, out of order %zu)\n", passed ? "passed" : "FAILED",
+           (unsigned long long)produced_sum, (unsigned long long)consumed_sum, out_of_order);
+
+    mpmc_queue_destroy(&context.queue, CF_NONE);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
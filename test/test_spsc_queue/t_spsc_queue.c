@@ -0,0 +1,119 @@
+/**
+ * @file t_spsc_queue.c
+ * @author Secareanu Filip
+ * @brief   Stress test of the SPSC queue.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A producer pushes the numbers 1 to T_SPSC_COUNT, alternating single and
+ * batched enqueues, through a queue much smaller than the stream, while a
+ * consumer drains it the same way. The consumer checks that every number
+ * arrives exactly once and in order, and the sums on both sides must match.
+ *
+ * Build and run with: make stress (built with ThreadSanitizer)
+ */
+
+#include "../../src/queue/spsc_queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#define T_SPSC_COUNT 200000
+#define T_SPSC_CAPACITY 64
+#define T_SPSC_BATCH 7
+
+typedef struct t_spsc_context {
+    spsc_queue_t *queue;
+    uint64_t produced_sum;
+    uint64_t consumed_sum;
+    size_t out_of_order;
+} t_spsc_context_t;
+
+static void *t_spsc_producer(void *arg)
+{
+    t_spsc_context_t *context = arg;
+    uint64_t next = 1;
+
+    while (next <= T_SPSC_COUNT) {
+        if (next % 2 == 0) {
+            uint64_t batch[T_SPSC_BATCH];
+            size_t count = 0;
+
+            while (count < T_SPSC_BATCH && next + count <= T_SPSC_COUNT) {
+                batch[count] = next + count;
+                count++;
+            }
+
+            size_t pushed = spsc_queue_enqueue_n(context->queue, batch, count);
+
+            for (size_t i = 0; i < pushed; i++) {
+                context->produced_sum += batch[i];
+            }
+            next += pushed;
+
+            if (pushed == 0) {
+                sched_yield();
+            }
+        } else if (spsc_queue_enqueue(context->queue, &next)) {
+            context->produced_sum += next;
+            next++;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *t_spsc_consumer(void *arg)
+{
+    t_spsc_context_t *context = arg;
+    uint64_t expected = 1;
+    uint64_t batch[T_SPSC_BATCH];
+
+    while (expected <= T_SPSC_COUNT) {
+        size_t count = spsc_queue_dequeue_n(context->queue, batch, expected % 3 == 0 ? 1 : T_SPSC_BATCH);
+
+        if (count == 0) {
+            sched_yield();
+            continue;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            if (batch[i] != expected) {
+                context->out_of_order++;
+            }
+            context->consumed_sum += batch[i];
+            expected++;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    t_spsc_context_t context = {0};
+    pthread_t producer;
+    pthread_t consumer;
+
+    context.queue = spsc_queue_create(sizeof(uint64_t), T_SPSC_CAPACITY, NULL, NULL);
+
+    pthread_create(&consumer, NULL, t_spsc_consumer, &context);
+    pthread_create(&producer, NULL, t_spsc_producer, &context);
+
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    uint64_t expected_sum = (uint64_t)T_SPSC_COUNT * (T_SPSC_COUNT + 1) / 2;
+    bool passed = context.out_of_order == 0 && context.produced_sum == expected_sum && context.consumed_sum == expected_sum && spsc_queue_is_empty(context.queue);
+
+    printf("t_spsc_queue: %s (produced %llu, consumed %llu, out of order %zu)\n", passed ? "passed" : "FAILED",
+           (unsigned long long)context.produced_sum, (unsigned long long)context.consumed_sum, context.out_of_order);
+
+    spsc_queue_destroy(&context.queue, CF_NONE);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
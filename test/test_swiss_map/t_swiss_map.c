@@ -0,0 +1,83 @@
+/**
+ * @file t_swiss_map.c
+ * @author Secareanu Filip
+ * @brief   Regression test of the SwissTable-style map across load factors.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * For every load factor, from far below one entry per group up to the 0.95
+ * cap, the map starts at its smallest size and is filled so it has to grow
+ * many times. Every key must then read back with its value. Half of the keys
+ * are removed and inserted again, so tombstones force the in-place cleanup
+ * as well as growth, and the map must end up holding every key exactly once.
+ *
+ * Build and run with: make check (built with AddressSanitizer)
+ */
+
+#include "../../src/hash_table/swiss_map.h"
+#include <stdio.h>
+
+#define T_SWISS_MAP_COUNT 20000
+
+static const float t_swiss_map_loads[] = {0.01f, 0.02f, 0.1f, 0.5f, 0.875f, 0.95f};
+
+static bool t_swiss_map_check(swiss_map_t *map)
+{
+    if (swiss_map_size(map) != T_SWISS_MAP_COUNT) {
+        return false;
+    }
+
+    for (uint64_t key = 0; key < T_SWISS_MAP_COUNT; key++) {
+        uint64_t *value = swiss_map_get(map, &key);
+
+        if (value == NULL || *value != key * 3 + 1) {
+            return false;
+        }
+    }
+
+    uint64_t missing = T_SWISS_MAP_COUNT;
+
+    return !swiss_map_contains(map, &missing);
+}
+
+int main(void)
+{
+    bool passed = true;
+
+    for (size_t i = 0; i < sizeof(t_swiss_map_loads) / sizeof(t_swiss_map_loads[0]); i++) {
+        swiss_map_t *map = swiss_map_create(sizeof(uint64_t), sizeof(uint64_t), 0, t_swiss_map_loads[i], NULL, NULL, NULL, NULL);
+
+        for (uint64_t key = 0; key < T_SWISS_MAP_COUNT; key++) {
+            uint64_t value = key * 3 + 1;
+
+            swiss_map_insert(map, &key, &value);
+        }
+
+        bool filled = t_swiss_map_check(map);
+
+        for (uint64_t key = 0; key < T_SWISS_MAP_COUNT; key += 2) {
+            swiss_map_remove(map, &key);
+        }
+        for (uint64_t key = 0; key < T_SWISS_MAP_COUNT; key += 2) {
+            uint64_t value = key * 3 + 1;
+
+            swiss_map_insert(map, &key, &value);
+        }
+
+        bool refilled = t_swiss_map_check(map);
+
+        if (!filled || !refilled) {
+            printf("t_swiss_map: load factor %.2f failed (after filling %s, after refilling %s)\n", t_swiss_map_loads[i],
+                   filled ? "ok" : "wrong", refilled ? "ok" : "wrong");
+            passed = false;
+        }
+
+        swiss_map_destroy(&map, CF_NONE);
+    }
+
+    printf("t_swiss_map: %s (%d keys per load factor)\n", passed ? "passed" : "FAILED", T_SWISS_MAP_COUNT);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
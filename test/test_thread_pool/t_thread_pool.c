@@ -0,0 +1,156 @@
+/**
+ * @file t_thread_pool.c
+ * @author Secareanu Filip
+ * @brief   Stress test of the work-stealing thread pool.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Three workloads run on one pool, several rounds each:
+ *  - plain tasks submitted from outside, more than the injector holds, each
+ *    spawning children from inside the pool, so the totals depend on every
+ *    task running exactly once;
+ *  - a parallel_for that marks every index, which must be covered exactly
+ *    once whatever the grain;
+ *  - a parallel_for whose pieces run a nested parallel_for.
+ *
+ * Build and run with: make stress (built with ThreadSanitizer)
+ */
+
+#include "../../src/scheduler/thread_pool.h"
+#include <stdio.h>
+
+#define T_POOL_THREADS 4
+#define T_POOL_ROUNDS 5
+#define T_POOL_TASKS 3000
+#define T_POOL_CHILDREN 3
+#define T_POOL_RANGE 100000
+#define T_POOL_NESTED 64
+
+typedef struct t_pool_context {
+    thread_pool_t *pool;
+    _Atomic uint64_t task_sum;
+    _Atomic size_t task_count;
+    _Atomic unsigned char marks[T_POOL_RANGE];
+    _Atomic size_t bad_marks;
+    _Atomic uint64_t nested_sum;
+} t_pool_context_t;
+
+typedef struct t_pool_task {
+    t_pool_context_t *context;
+    uint64_t value;
+} t_pool_task_t;
+
+static t_pool_task_t t_pool_tasks[T_POOL_TASKS * (T_POOL_CHILDREN + 1)];
+
+static void t_pool_child(void *arg)
+{
+    t_pool_task_t *task = arg;
+
+    atomic_fetch_add(&task->context->task_sum, task->value);
+    atomic_fetch_add(&task->context->task_count, 1);
+}
+
+static void t_pool_parent(void *arg)
+{
+    t_pool_task_t *task = arg;
+    size_t index = task - t_pool_tasks;
+
+    // Children go to this worker's own deque, where other workers can steal them
+    for (size_t i = 1; i <= T_POOL_CHILDREN; i++) {
+        thread_pool_submit(task->context->pool, t_pool_child, &t_pool_tasks[index + i]);
+    }
+
+    t_pool_child(arg);
+}
+
+static void t_pool_mark(size_t begin, size_t end, void *arg)
+{
+    t_pool_context_t *context = arg;
+
+    for (size_t i = begin; i < end; i++) {
+        if (atomic_fetch_add(&context->marks[i], 1) != 0) {
+            atomic_fetch_add(&context->bad_marks, 1);
+        }
+    }
+}
+
+static void t_pool_inner(size_t begin, size_t end, void *arg)
+{
+    t_pool_context_t *context = arg;
+    uint64_t sum = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        sum += i;
+    }
+
+    atomic_fetch_add(&context->nested_sum, sum);
+}
+
+static void t_pool_outer(size_t begin, size_t end, void *arg)
+{
+    t_pool_context_t *context = arg;
+
+    for (size_t i = begin; i < end; i++) {
+        parallel_for(context->pool, 0, T_POOL_NESTED, 4, t_pool_inner, context);
+    }
+}
+
+int main(void)
+{
+    static t_pool_context_t context;
+    bool passed = true;
+
+    context.pool = thread_pool_create(T_POOL_THREADS);
+
+    for (size_t round = 0; round < T_POOL_ROUNDS; round++) {
+        atomic_store(&context.task_sum, 0);
+        atomic_store(&context.task_count, 0);
+        atomic_store(&context.bad_marks, 0);
+        atomic_store(&context.nested_sum, 0);
+
+        for (size_t i = 0; i < T_POOL_RANGE; i++) {
+            atomic_store(&context.marks[i], 0);
+        }
+
+        for (size_t i = 0; i < T_POOL_TASKS * (T_POOL_CHILDREN + 1); i++) {
+            t_pool_tasks[i].context = &context;
+            t_pool_tasks[i].value = i + 1;
+        }
+
+        for (size_t i = 0; i < T_POOL_TASKS; i++) {
+            thread_pool_submit(context.pool, t_pool_parent, &t_pool_tasks[i * (T_POOL_CHILDREN + 1)]);
+        }
+        thread_pool_wait(context.pool);
+
+        parallel_for(context.pool, 0, T_POOL_RANGE, round == 0 ? 0 : round * 97, t_pool_mark, &context);
+        parallel_for(context.pool, 0, T_POOL_NESTED, 1, t_pool_outer, &context);
+
+        size_t total = T_POOL_TASKS * (T_POOL_CHILDREN + 1);
+        size_t unmarked = 0;
+
+        for (size_t i = 0; i < T_POOL_RANGE; i++) {
+            unmarked += atomic_load(&context.marks[i]) == 0;
+        }
+
+        uint64_t nested_expected = (uint64_t)T_POOL_NESTED * (T_POOL_NESTED * (T_POOL_NESTED - 1) / 2);
+        bool round_passed = atomic_load(&context.task_count) == total &&
+                            atomic_load(&context.task_sum) == (uint64_t)total * (total + 1) / 2 &&
+                            unmarked == 0 && atomic_load(&context.bad_marks) == 0 &&
+                            atomic_load(&context.nested_sum) == nested_expected;
+
+        if (!round_passed) {
+            printf("t_thread_pool: round %zu failed (tasks %zu of %zu, unmarked %zu, marked twice %zu, nested %llu of %llu)\n",
+                   round, atomic_load(&context.task_count), total, unmarked, atomic_load(&context.bad_marks),
+                   (unsigned long long)atomic_load(&context.nested_sum), (unsigned long long)nested_expected);
+            passed = false;
+        }
+    }
+
+    thread_pool_destroy(&context.pool);
+
+    printf("t_thread_pool: %s (%d rounds on %d workers)\n", passed ? "passed" : "FAILED", T_POOL_ROUNDS, T_POOL_THREADS);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file t_ws_deque.c
+ * @author Secareanu Filip
+ * @brief   Stress test of the work-stealing deque.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The owner pushes distinct numbers in bursts and pops some of them back,
+ * starting from a tiny array so it grows while thieves are active, and the
+ * thieves steal until everything has been taken. Every number must be taken
+ * exactly once, by the owner or by a thief, which the sums and a per-number
+ * mark check; the races for the last element are the interesting part.
+ *
+ * Build and run with: make stress (built with ThreadSanitizer)
+ */
+
+#include "../../src/deque/ws_deque.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#define T_WS_DEQUE_THIEVES 3
+#define T_WS_DEQUE_COUNT 200000
+#define T_WS_DEQUE_BURST 16
+
+typedef struct t_ws_deque_context {
+    ws_deque_t *deque;
+    _Atomic size_t taken;
+    _Atomic uint64_t taken_sum;
+    _Atomic size_t duplicates;
+    _Atomic unsigned char seen[T_WS_DEQUE_COUNT + 1];
+} t_ws_deque_context_t;
+
+static void t_ws_deque_take(t_ws_deque_context_t *context, uint64_t value, uint64_t *sum)
+{
+    if (value == 0 || value > T_WS_DEQUE_COUNT || atomic_exchange(&context->seen[value], 1) != 0) {
+        atomic_fetch_add(&context->duplicates, 1);
+    }
+
+    *sum += value;
+    atomic_fetch_add(&context->taken, 1);
+}
+
+static void *t_ws_deque_thief(void *arg)
+{
+    t_ws_deque_context_t *context = arg;
+    uint64_t sum = 0;
+    uint64_t value;
+
+    while (atomic_load(&context->taken) < T_WS_DEQUE_COUNT) {
+        if (ws_deque_steal(context->deque, &value)) {
+            t_ws_deque_take(context, value, &sum);
+        } else {
+            sched_yield();
+        }
+    }
+
+    atomic_fetch_add(&context->taken_sum, sum);
+
+    return NULL;
+}
+
+int main(void)
+{
+    static t_ws_deque_context_t context;
+    pthread_t thieves[T_WS_DEQUE_THIEVES];
+    uint64_t sum = 0;
+    uint64_t value;
+
+    context.deque = ws_deque_create(sizeof(uint64_t), 2, 0.75f, NULL, NULL);
+
+    for (size_t i = 0; i < T_WS_DEQUE_THIEVES; i++) {
+        pthread_create(&thieves[i], NULL, t_ws_deque_thief, &context);
+    }
+
+    for (uint64_t next = 1; next <= T_WS_DEQUE_COUNT;) {
+        for (size_t i = 0; i < T_WS_DEQUE_BURST && next <= T_WS_DEQUE_COUNT; i++) {
+            ws_deque_push(context.deque, &next);
+            next++;
+        }
+
+        // Pop about half back, so the owner and the thieves meet on the last element
+        for (size_t i = 0; i < T_WS_DEQUE_BURST / 2 && ws_deque_pop(context.deque, &value); i++) {
+            t_ws_deque_take(&context, value, &sum);
+        }
+    }
+
+    while (atomic_load(&context.taken) < T_WS_DEQUE_COUNT) {
+        if (ws_deque_pop(context.deque, &value)) {
+            t_ws_deque_take(&context, value, &sum);
+        }
+    }
+
+    for (size_t i = 0; i < T_WS_DEQUE_THIEVES; i++) {
+        pthread_join(thieves[i], NULL);
+    }
+
+    atomic_fetch_add(&context.taken_sum, sum);
+
+    uint64_t expected_sum = (uint64_t)T_WS_DEQUE_COUNT * (T_WS_DEQUE_COUNT + 1) / 2;
+    uint64_t taken_sum = atomic_load(&context.taken_sum);
+    size_t taken = atomic_load(&context.taken);
+    size_t duplicates = atomic_load(&context.duplicates);
+    bool passed = duplicates == 0 && taken == T_WS_DEQUE_COUNT && taken_sum == expected_sum && ws_deque_is_empty(context.deque);
+
+    printf("t_ws_deque: %s (taken %zu, sum %llu, duplicates %zu)\n", passed ? "passed" : "FAILED",
+           taken, (unsigned long long)taken_sum, duplicates);
+
+    ws_deque_destroy(&context.deque, CF_NONE);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}